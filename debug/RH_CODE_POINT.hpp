@@ -2,14 +2,137 @@
 #ifndef __RH_CODE_POINT_hpp__
 #define __RH_CODE_POINT_hpp__
 
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+
 #include <boost/current_function.hpp>
 
-#define RH_CODE_POINT              \
-  (std::string(__FILE__)           \
-   + std::string(":")              \
-   + std::to_string(__LINE__)      \
-   + std::string(": ")             \
-   + std::string(BOOST_CURRENT_FUNCTION))
+// One static record per call site: file, line and function are kept as
+// std::string_view of the literals and the record gets a small integer id
+// the first time the site is reached. Passing the record (or its id)
+// around costs nothing; "file:line: function" is only built by str().
+
+class RH_CodePoint {
+ public:
+  using Id = uint32_t;
+
+  // 0 is never given to a record.
+  static constexpr Id noId = 0;
+
+  RH_CodePoint(const char* file, unsigned line, const char* function) noexcept
+      : file_(file), function_(function), line_(line),
+        id_(idsCount_.fetch_add(1, std::memory_order_relaxed) + 1),
+        next_(first_.load(std::memory_order_relaxed)) {
+    while(!first_.compare_exchange_weak(next_, this,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {}
+  }
+
+  // A copy is a value with the site and id of the record, not listed by
+  // find() and forEach(), e.g. for auto point = RH_CODE_POINT.
+  RH_CodePoint(const RH_CodePoint&) = default;
+  RH_CodePoint& operator=(const RH_CodePoint&) = default;
+
+  std::string_view file() const noexcept {
+    return file_;
+  }
+
+  unsigned line() const noexcept {
+    return line_;
+  }
+
+  std::string_view function() const noexcept {
+    return function_;
+  }
+
+  Id id() const noexcept {
+    return id_;
+  }
+
+  std::string str() const {
+    std::string result;
+    result.reserve(file_.size() + function_.size() + 16);
+    result += file_;
+    result += ':';
+    result += std::to_string(line_);
+    result += ": ";
+    result += function_;
+    return result;
+  }
+
+  operator std::string() const {
+    return str();
+  }
+
+  // Record with id, or nullptr if no such site has been reached yet.
+  static const RH_CodePoint* find(Id id) noexcept {
+    for(const RH_CodePoint* point = first_.load(std::memory_order_acquire);
+        point; point = point->next_) {
+      if(point->id_ == id) return point;
+    }
+    return nullptr;
+  }
+
+  // Calls f(const RH_CodePoint&) for every site reached so far.
+  template<typename F>
+  static void forEach(F&& f) {
+    for(const RH_CodePoint* point = first_.load(std::memory_order_acquire);
+        point; point = point->next_) {
+      f(*point);
+    }
+  }
+
+ private:
+  std::string_view file_;
+  std::string_view function_;
+  unsigned line_;
+  Id id_;
+  const RH_CodePoint* next_;
+
+  static inline std::atomic<Id> idsCount_{0};
+  static inline std::atomic<const RH_CodePoint*> first_{nullptr};
+};
+
+inline std::ostream& operator<<(std::ostream& stream,
+                                const RH_CodePoint& point) {
+  return stream << point.file() << ':' << point.line() << ": "
+                << point.function();
+}
+
+inline std::string operator+(const std::string& text,
+                             const RH_CodePoint& point) {
+  return text + point.str();
+}
+
+inline std::string operator+(const RH_CodePoint& point,
+                             const std::string& text) {
+  return point.str() + text;
+}
+
+// Site is the type of a lambda written at the call site, so every call
+// site gets its own record.
+template<typename Site>
+const RH_CodePoint& RH__CodePoint(Site, const char* file, unsigned line,
+                                  const char* function) noexcept {
+  static const RH_CodePoint point(file, line, function);
+  return point;
+}
+
+// const RH_CodePoint& of the call site. Converts to the std::string
+// "file:line: function" of the former RH_CODE_POINT on demand, but is no
+// std::string itself: auto point = RH_CODE_POINT copies the record, so
+// code calling std::string members on it, e.g. point.c_str() or
+// point.size(), calls them on point.str() or declares point a
+// std::string.
+#define RH_CODE_POINT \
+  (RH__CodePoint([] {}, __FILE__, __LINE__, BOOST_CURRENT_FUNCTION))
 // #define RH_CODE_POINT
 
+#define RH_CODE_POINT_ID (RH_CODE_POINT.id())
+// #define RH_CODE_POINT_ID
+
 #endif // __RH_CODE_POINT_hpp__
@@ -0,0 +1,322 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+#ifndef __RH_PROFILE_hpp__
+#define __RH_PROFILE_hpp__
+
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <vector>
+
+#include "RH_CODE_POINT.hpp"
+#include "RH_THREAD_RECYCLED.hpp"
+#include "RH_TRACE.hpp"
+
+// Latency profiling of code blocks under live load.
+//
+// RH_PROFILE_ZONE times the rest of the enclosing block with RH_TraceClock
+// and records the duration in a histogram of its own per zone (the
+// RH_CODE_POINT of the macro) and per thread, so recording takes no
+// locks. RH_Profile::report() merges the histograms of all threads and
+// can be called periodically, e.g. from a timer, while zones keep
+// recording; counts only grow.
+//
+// RH_PROFILE_ZONE is compiled out unless RH_USE_PROFILE is defined.
+
+// Zones with code point ids from this value on are not recorded, only
+// counted, see RH_Profile::droppedCount(), as are timings whose tables
+// could not be allocated. Zone ids are RH_CODE_POINT
+// ids, shared with every other code point site, and the table of a
+// thread is allocated by pages of ids as its zones are first recorded.
+#ifndef RH_PROFILE_ZONES
+#define RH_PROFILE_ZONES (1 << 16)
+#endif
+
+// Log-linear (HDR style) histogram: values below 32 get a bucket each,
+// larger values get 32 buckets per power of two, so a bucket is within
+// about 3% of the values it counts. Values from 2^48 on share the last
+// bucket. Written by one thread, read by any.
+class RH_ProfileHistogram {
+ public:
+  static constexpr unsigned subBucketsBits = 5;
+  static constexpr uint64_t subBuckets = uint64_t(1) << subBucketsBits;
+  static constexpr unsigned valueBits = 48;
+  static constexpr size_t bucketsCount =
+    (valueBits - subBucketsBits + 1) * subBuckets;
+
+  static constexpr size_t bucketIndex(uint64_t value) noexcept {
+    if(value >= (uint64_t(1) << valueBits)) return bucketsCount - 1;
+    if(value < subBuckets) return value;
+    const unsigned shift = 63 - __builtin_clzll(value) - subBucketsBits;
+    return shift * subBuckets + (value >> shift);
+  }
+
+  // Highest value counted by bucket index.
+  static constexpr uint64_t bucketValue(size_t index) noexcept {
+    if(index < 2 * subBuckets) return index;
+    const unsigned shift = index / subBuckets - 1;
+    return ((index - shift * subBuckets + 1) << shift) - 1;
+  }
+
+  // Owner thread only.
+  void record(uint64_t value) noexcept {
+    increase(counts_[bucketIndex(value)], 1);
+    increase(count_, 1);
+    increase(sum_, value);
+    if(value > max_.load(std::memory_order_relaxed)) {
+      max_.store(value, std::memory_order_relaxed);
+    }
+  }
+
+  // Adds the counts of other to this histogram, which must not be
+  // recorded into meanwhile.
+  void add(const RH_ProfileHistogram& other) noexcept {
+    for(size_t i = 0; i < bucketsCount; ++i) {
+      increase(counts_[i], other.counts_[i].load(std::memory_order_relaxed));
+    }
+    increase(count_, other.count());
+    increase(sum_, other.sum());
+    if(other.max() > max()) max_.store(other.max(), std::memory_order_relaxed);
+  }
+
+  uint64_t count() const noexcept {
+    return count_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t sum() const noexcept {
+    return sum_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t max() const noexcept {
+    return max_.load(std::memory_order_relaxed);
+  }
+
+  // Smallest bucket value with at least quantile of the counts at or
+  // below it, never above max().
+  uint64_t quantile(double quantile) const noexcept {
+    uint64_t total = 0;
+    for(size_t i = 0; i < bucketsCount; ++i) {
+      total += counts_[i].load(std::memory_order_relaxed);
+    }
+    if(total == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(quantile * total + 0.5);
+    if(rank < 1) rank = 1;
+    uint64_t seen = 0;
+    for(size_t i = 0; i < bucketsCount; ++i) {
+      seen += counts_[i].load(std::memory_order_relaxed);
+      if(seen >= rank) return std::min(bucketValue(i), max());
+    }
+    return max();
+  }
+
+ private:
+  static void increase(std::atomic<uint64_t>& counter,
+                       uint64_t value) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + value,
+                  std::memory_order_relaxed);
+  }
+
+  std::atomic<uint64_t> counts_[bucketsCount] = {};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> max_{0};
+};
+
+// Histograms of one thread, by zone code point id. Never freed, like
+// RH_TraceRing, and recycled the same way: a thread started later takes
+// over the histograms of a finished one and adds to their counts.
+class RH_ProfileThread {
+ public:
+  // nullptr when no table could be allocated.
+  static RH_ProfileThread* local() noexcept {
+    return RH_ThreadRecycled<RH_ProfileThread>::local();
+  }
+
+  // Allocates the histogram on the first call for a zone in a thread;
+  // counts the calls for zones beyond RH_PROFILE_ZONES or whose
+  // histogram could not be allocated.
+  RH_ProfileHistogram* histogram(RH_CodePoint::Id zoneId) noexcept {
+    if(zoneId >= RH_PROFILE_ZONES) return dropped();
+    std::atomic<Page*>& pageSlot = pages_[zoneId / pageZones];
+    Page* page = pageSlot.load(std::memory_order_relaxed);
+    if(!page) {
+      page = new(std::nothrow) Page();
+      if(!page) return dropped();
+      pageSlot.store(page, std::memory_order_release);
+    }
+    std::atomic<RH_ProfileHistogram*>& histogramSlot =
+      page->histograms[zoneId % pageZones];
+    RH_ProfileHistogram* histogram =
+      histogramSlot.load(std::memory_order_relaxed);
+    if(!histogram) {
+      histogram = new(std::nothrow) RH_ProfileHistogram();
+      if(!histogram) return dropped();
+      histogramSlot.store(histogram, std::memory_order_release);
+    }
+    return histogram;
+  }
+
+  const RH_ProfileHistogram* histogramIfAny(RH_CodePoint::Id zoneId) const {
+    if(zoneId >= RH_PROFILE_ZONES) return nullptr;
+    const Page* page =
+      pages_[zoneId / pageZones].load(std::memory_order_acquire);
+    return page
+      ? page->histograms[zoneId % pageZones].load(std::memory_order_acquire)
+      : nullptr;
+  }
+
+  // Zone timings not recorded.
+  uint64_t droppedCount() const noexcept {
+    return droppedCount_.load(std::memory_order_relaxed);
+  }
+
+  template<typename F>
+  static void forEach(F&& f) {
+    for(const RH_ProfileThread* thread =
+          first_.load(std::memory_order_acquire);
+        thread; thread = thread->next_) {
+      f(*thread);
+    }
+  }
+
+ private:
+  friend class RH_ThreadRecycled<RH_ProfileThread>;
+
+  RH_ProfileThread() noexcept
+      : next_(first_.load(std::memory_order_relaxed)) {
+    RH_TraceClock::originTicks();
+    while(!first_.compare_exchange_weak(next_, this,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {}
+  }
+
+  RH_ProfileHistogram* dropped() noexcept {
+    droppedCount_.store(droppedCount_.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  static constexpr size_t pageZones = 256;
+  static constexpr size_t pagesCount =
+    (RH_PROFILE_ZONES + pageZones - 1) / pageZones;
+
+  struct Page {
+    std::atomic<RH_ProfileHistogram*> histograms[pageZones] = {};
+  };
+
+  std::atomic<Page*> pages_[pagesCount] = {};
+  std::atomic<uint64_t> droppedCount_{0};
+  const RH_ProfileThread* next_;
+
+  static inline std::atomic<const RH_ProfileThread*> first_{nullptr};
+};
+
+class RH_ProfileZone {
+ public:
+  explicit RH_ProfileZone(RH_CodePoint::Id zoneId)
+      : histogram_(histogram(zoneId)),
+        start_(RH_TraceClock::ticks())
+  {}
+
+  RH_ProfileZone(const RH_ProfileZone&) = delete;
+  RH_ProfileZone& operator=(const RH_ProfileZone&) = delete;
+
+  ~RH_ProfileZone() {
+    if(histogram_) histogram_->record(RH_TraceClock::ticks() - start_);
+  }
+
+ private:
+  static RH_ProfileHistogram* histogram(RH_CodePoint::Id zoneId) noexcept {
+    RH_ProfileThread* thread = RH_ProfileThread::local();
+    return thread ? thread->histogram(zoneId) : nullptr;
+  }
+
+  RH_ProfileHistogram* const histogram_;
+  const uint64_t start_;
+};
+
+class RH_Profile {
+ public:
+  // Durations in nanoseconds.
+  struct Zone {
+    const RH_CodePoint* codePoint;
+    uint64_t count;
+    double mean;
+    double p50;
+    double p99;
+    double p999;
+    double max;
+  };
+
+  // Zones recorded so far by any thread, merged.
+  static std::vector<Zone> report() {
+    const double nanoSecondsPerTick =
+      1000.0 / RH_TraceClock::ticksPerMicroSecond();
+    std::vector<Zone> zones;
+    RH_CodePoint::forEach([&](const RH_CodePoint& codePoint) {
+      auto merged = std::make_unique<RH_ProfileHistogram>();
+      RH_ProfileThread::forEach([&](const RH_ProfileThread& thread) {
+        const RH_ProfileHistogram* histogram =
+          thread.histogramIfAny(codePoint.id());
+        if(histogram) merged->add(*histogram);
+      });
+      if(merged->count() == 0) return;
+      zones.push_back(
+        Zone{&codePoint, merged->count(),
+             merged->sum() * nanoSecondsPerTick / merged->count(),
+             merged->quantile(0.5) * nanoSecondsPerTick,
+             merged->quantile(0.99) * nanoSecondsPerTick,
+             merged->quantile(0.999) * nanoSecondsPerTick,
+             merged->max() * nanoSecondsPerTick});
+    });
+    return zones;
+  }
+
+  // Zone timings not recorded by any thread, their code point ids being
+  // beyond RH_PROFILE_ZONES or their histograms not allocated.
+  static uint64_t droppedCount() {
+    uint64_t count = 0;
+    RH_ProfileThread::forEach([&count](const RH_ProfileThread& thread) {
+      count += thread.droppedCount();
+    });
+    return count;
+  }
+
+  static void writeReport(std::ostream& stream) {
+    const std::ios::fmtflags flags = stream.flags();
+    stream << std::fixed << std::setprecision(0)
+           << "   count    mean     p50     p99   p99.9     max  ns  zone"
+           << std::endl;
+    for(const Zone& zone : report()) {
+      stream << std::setw(8) << zone.count << std::setw(8) << zone.mean
+             << std::setw(8) << zone.p50 << std::setw(8) << zone.p99
+             << std::setw(8) << zone.p999 << std::setw(8) << zone.max
+             << "      " << *zone.codePoint << std::endl;
+    }
+    if(const uint64_t dropped = droppedCount()) {
+      stream << std::setw(8) << dropped
+             << "  not recorded: zone ids beyond RH_PROFILE_ZONES "
+             << RH_PROFILE_ZONES << " or out of memory" << std::endl;
+    }
+    stream.flags(flags);
+  }
+};
+
+#define RH__PROFILE_CONCAT_(a, b) a ## b
+#define RH__PROFILE_CONCAT(a, b) RH__PROFILE_CONCAT_(a, b)
+
+#ifdef RH_USE_PROFILE
+
+#define RH_PROFILE_ZONE                                                 \
+  RH_ProfileZone RH__PROFILE_CONCAT(rhProfileZone, __LINE__)(           \
+    RH_CODE_POINT_ID)
+
+#else
+
+#define RH_PROFILE_ZONE ((void)0)
+
+#endif // RH_USE_PROFILE
+
+#endif // __RH_PROFILE_hpp__
@@ -0,0 +1,77 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+#ifndef __RH_THREAD_RECYCLED_hpp__
+#define __RH_THREAD_RECYCLED_hpp__
+
+#include <mutex>
+#include <new>
+#include <vector>
+
+// Per-thread T of the debug facilities (trace rings, profile tables),
+// recycled: when a thread exits its T goes on a free list and the next
+// thread needing one takes it instead of allocating another, so threads
+// created on demand do not grow memory without bound. Ts are never freed
+// and keep their contents when recycled, so T::T() must be accessible
+// to RH_ThreadRecycled<T>.
+template<typename T>
+class RH_ThreadRecycled {
+ public:
+  // The T of the calling thread, taken or allocated on the first call in
+  // the thread; nullptr when it could not be allocated. A T taken while
+  // the thread exits is not recycled.
+  static T* local() noexcept {
+    if(T* object = object_) return object;
+    return acquire();
+  }
+
+ private:
+  struct FreeList {
+    std::mutex mutex;
+    std::vector<T*> objects;
+  };
+
+  // Never destroyed, as threads may exit after static destruction began.
+  static FreeList& freeList() noexcept {
+    static FreeList* freeList = new FreeList();
+    return *freeList;
+  }
+
+  struct Releaser {
+    bool armed = false;
+
+    ~Releaser() {
+      exited_ = true;
+      T* object = object_;
+      object_ = nullptr;
+      if(!object) return;
+      FreeList& list = freeList();
+      std::lock_guard<std::mutex> lock(list.mutex);
+      try {
+        list.objects.push_back(object);
+      }
+      catch(const std::bad_alloc&) {}
+    }
+  };
+
+  static T* acquire() noexcept {
+    T* object = nullptr;
+    {
+      FreeList& list = freeList();
+      std::lock_guard<std::mutex> lock(list.mutex);
+      if(!list.objects.empty()) {
+        object = list.objects.back();
+        list.objects.pop_back();
+      }
+    }
+    if(!object) object = new(std::nothrow) T();
+    if(!object) return nullptr;
+    object_ = object;
+    if(!exited_) releaser_.armed = true;
+    return object;
+  }
+
+  static inline thread_local T* object_ = nullptr;
+  static inline thread_local bool exited_ = false;
+  static inline thread_local Releaser releaser_;
+};
+
+#endif // __RH_THREAD_RECYCLED_hpp__
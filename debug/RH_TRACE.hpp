@@ -0,0 +1,362 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+#ifndef __RH_TRACE_hpp__
+#define __RH_TRACE_hpp__
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "RH_CODE_POINT.hpp"
+#include "RH_THREAD_RECYCLED.hpp"
+#include "reflection/RH_FIELDS_BINARY.hpp"
+#include "reflection/RH_FIELDS_TEXT.hpp"
+
+// Binary event tracing for hot paths.
+//
+// RH_TRACE(arg0, arg1) records an instant event, RH_TRACE_SCOPE(arg0, arg1)
+// a begin event and, when the scope ends, an end event. An event is the
+// RH_CODE_POINT id of the site, a time stamp counter reading and two
+// 64-bit arguments (32 bytes), written to the calling thread's ring with
+// no locks, no allocation and no formatting.
+//
+// Both macros are compiled out unless RH_USE_TRACE is defined.
+//
+// RH_Trace::snapshot() copies all rings; the snapshot is written in
+// binary with writeBinary() and turned into Chrome trace / Perfetto JSON
+// with writeChromeTrace(), in process or offline by RH_TRACE_dump.
+
+// Events kept per thread, older ones are overwritten.
+#ifndef RH_TRACE_RING_EVENTS
+#define RH_TRACE_RING_EVENTS (1 << 14)
+#endif
+
+struct RH_TraceEvent {
+  enum Phase : uint32_t { instant, begin, end };
+
+  uint64_t ticks;
+  RH_CodePoint::Id codePointId;
+  uint32_t phase;
+  uint64_t args[2];
+};
+
+class RH_TraceClock {
+ public:
+  // Time stamp counter where there is one, steady clock nanoseconds
+  // elsewhere.
+  static uint64_t ticks() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return nanoSeconds();
+#endif
+  }
+
+  static uint64_t nanoSeconds() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  // Ticks and nanoseconds when the clock was first used.
+  static uint64_t originTicks() noexcept {
+    return origin().ticks;
+  }
+
+  static uint64_t originNanoSeconds() noexcept {
+    return origin().nanoSeconds;
+  }
+
+  // Measured against the steady clock since the origin; waits until
+  // 10 ms have passed since then so the ratio is meaningful.
+  static double ticksPerMicroSecond() noexcept {
+    uint64_t nanoSeconds = 0;
+    uint64_t ticks = 0;
+    do {
+      ticks = RH_TraceClock::ticks() - originTicks();
+      nanoSeconds = RH_TraceClock::nanoSeconds() - originNanoSeconds();
+    } while(nanoSeconds < 10000000);
+    return ticks * 1000.0 / nanoSeconds;
+  }
+
+ private:
+  struct Origin {
+    uint64_t ticks = RH_TraceClock::ticks();
+    uint64_t nanoSeconds = RH_TraceClock::nanoSeconds();
+  };
+
+  static const Origin& origin() noexcept {
+    static const Origin origin;
+    return origin;
+  }
+};
+
+// One per thread tracing. Rings are never freed: the ring of a finished
+// thread keeps its events, to be dumped, until a thread started later
+// takes it over with its thread index, like an OS reusing a thread id.
+class RH_TraceRing {
+ public:
+  static constexpr size_t capacity = RH_TRACE_RING_EVENTS;
+  static_assert((capacity & (capacity - 1)) == 0,
+                "RH_TRACE_RING_EVENTS must be a power of two");
+
+  // nullptr when no ring could be allocated; the events of the thread
+  // are dropped then.
+  static RH_TraceRing* local() noexcept {
+    return RH_ThreadRecycled<RH_TraceRing>::local();
+  }
+
+  static void writeLocal(RH_CodePoint::Id codePointId,
+                         RH_TraceEvent::Phase phase,
+                         uint64_t arg0, uint64_t arg1) noexcept {
+    if(RH_TraceRing* ring = local()) {
+      ring->write(codePointId, phase, arg0, arg1);
+    }
+  }
+
+  void write(RH_CodePoint::Id codePointId, RH_TraceEvent::Phase phase,
+             uint64_t arg0, uint64_t arg1) noexcept {
+    const uint64_t written = written_.load(std::memory_order_relaxed);
+    begun_.store(written + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    events_[written & (capacity - 1)] =
+      RH_TraceEvent{RH_TraceClock::ticks(), codePointId, phase, {arg0, arg1}};
+    written_.store(written + 1, std::memory_order_release);
+  }
+
+  uint32_t threadIndex() const noexcept {
+    return threadIndex_;
+  }
+
+  // Appends the events still in the ring to events and returns how many
+  // were overwritten before they could be copied.
+  uint64_t copy(std::vector<RH_TraceEvent>& events) const {
+    const uint64_t end = written_.load(std::memory_order_acquire);
+    uint64_t begin = end > capacity ? end - capacity : 0;
+    const size_t first = events.size();
+    for(uint64_t i = begin; i < end; ++i) {
+      events.push_back(events_[i & (capacity - 1)]);
+    }
+    // Events whose slots were begun being written over while copying are
+    // dropped: event i goes when event i + capacity is begun.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t begun = begun_.load(std::memory_order_relaxed);
+    if(begun > capacity && begun - capacity > begin) {
+      const uint64_t overwritten = std::min(begun - capacity, end) - begin;
+      events.erase(events.begin() + first,
+                   events.begin() + first + overwritten);
+      begin += overwritten;
+    }
+    return begin;
+  }
+
+  template<typename F>
+  static void forEach(F&& f) {
+    for(const RH_TraceRing* ring = first_.load(std::memory_order_acquire);
+        ring; ring = ring->next_) {
+      f(*ring);
+    }
+  }
+
+  RH_TraceRing() noexcept
+      : threadIndex_(threadsCount_.fetch_add(1, std::memory_order_relaxed)),
+        next_(first_.load(std::memory_order_relaxed)) {
+    RH_TraceClock::originTicks();
+    while(!first_.compare_exchange_weak(next_, this,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {}
+  }
+
+  RH_TraceEvent events_[capacity];
+
+  // Events begun, published before the writer touches a slot, and
+  // written.
+  std::atomic<uint64_t> begun_{0};
+  std::atomic<uint64_t> written_{0};
+  const uint32_t threadIndex_;
+  const RH_TraceRing* next_;
+
+  static inline std::atomic<uint32_t> threadsCount_{0};
+  static inline std::atomic<const RH_TraceRing*> first_{nullptr};
+};
+
+class RH_TraceScope {
+ public:
+  RH_TraceScope(RH_CodePoint::Id codePointId, uint64_t arg0, uint64_t arg1)
+      : ring_(RH_TraceRing::local()), codePointId_(codePointId) {
+    if(ring_) ring_->write(codePointId, RH_TraceEvent::begin, arg0, arg1);
+  }
+
+  RH_TraceScope(const RH_TraceScope&) = delete;
+  RH_TraceScope& operator=(const RH_TraceScope&) = delete;
+
+  ~RH_TraceScope() {
+    if(ring_) ring_->write(codePointId_, RH_TraceEvent::end, 0, 0);
+  }
+
+ private:
+  RH_TraceRing* const ring_;
+  const RH_CodePoint::Id codePointId_;
+};
+
+// One entry of the Chrome trace event format, named as its JSON keys.
+struct RH_TraceChromeEvent {
+  struct Args {
+    uint64_t arg0;
+    uint64_t arg1;
+
+    RH_FIELDS(Args, arg0, arg1)
+  };
+
+  std::string_view name;
+  std::string_view cat;
+  std::string_view ph;
+  double ts;
+  uint32_t pid;
+  uint32_t tid;
+  Args args;
+
+  RH_FIELDS(RH_TraceChromeEvent, name, cat, ph, ts, pid, tid, args)
+};
+
+// Everything a dump needs, detached from the process that traced.
+struct RH_TraceSnapshot {
+  struct CodePoint {
+    uint32_t id;
+    uint32_t line;
+    std::string file;
+    std::string function;
+
+    RH_FIELDS(CodePoint, id, line, file, function)
+  };
+
+  struct Thread {
+    uint32_t index;
+    uint64_t overwritten;
+    std::vector<RH_TraceEvent> events;
+
+    RH_FIELDS(Thread, index, overwritten, events)
+  };
+
+  uint64_t originTicks;
+  double ticksPerMicroSecond;
+  std::vector<CodePoint> codePoints;
+  std::vector<Thread> threads;
+
+  RH_FIELDS(RH_TraceSnapshot, originTicks, ticksPerMicroSecond, codePoints,
+            threads)
+
+  void writeBinary(std::ostream& stream) const {
+    RH_BinaryWriter::Buffer buffer;
+    RH_BinaryWriter(buffer).write(*this);
+    stream.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+  }
+
+  // Throws std::runtime_error if data is not a whole snapshot.
+  static RH_TraceSnapshot readBinary(const unsigned char* data, size_t size) {
+    RH_TraceSnapshot snapshot;
+    RH_BinaryReader(data, size).read(snapshot);
+    return snapshot;
+  }
+
+  // Chrome trace event format: open in chrome://tracing or Perfetto.
+  void writeChromeTrace(std::ostream& stream) const {
+    std::map<uint32_t, const CodePoint*> codePointsById;
+    std::map<uint32_t, std::string> locationsById;
+    for(const CodePoint& codePoint : codePoints) {
+      codePointsById[codePoint.id] = &codePoint;
+      locationsById[codePoint.id] =
+        codePoint.file + ":" + std::to_string(codePoint.line);
+    }
+
+    char buffer[1 << 16];
+    RH_TextWriter writer(buffer);
+    auto put = [&](auto&& write) {
+      if(write()) return;
+      stream.write(writer.data(), writer.size());
+      writer.clear();
+      write();
+    };
+
+    bool first = true;
+    put([&] { return writer.write("{\"traceEvents\":[\n"); });
+    for(const Thread& thread : threads) {
+      for(const RH_TraceEvent& event : thread.events) {
+        RH_TraceChromeEvent chromeEvent{"?", "", "i",
+                          (event.ticks - originTicks) / ticksPerMicroSecond,
+                          1, thread.index, {event.args[0], event.args[1]}};
+        auto codePoint = codePointsById.find(event.codePointId);
+        if(codePoint != codePointsById.end()) {
+          chromeEvent.name = codePoint->second->function;
+          chromeEvent.cat = locationsById[event.codePointId];
+        }
+        if(event.phase == RH_TraceEvent::begin) chromeEvent.ph = "B";
+        else if(event.phase == RH_TraceEvent::end) chromeEvent.ph = "E";
+        if(!first) put([&] { return writer.write(",\n"); });
+        put([&] { return writer.writeJson(chromeEvent); });
+        first = false;
+      }
+    }
+    put([&] { return writer.write("\n]}\n"); });
+    stream.write(writer.data(), writer.size());
+  }
+};
+
+class RH_Trace {
+ public:
+  // Copies the rings of all threads and the code points they refer to.
+  static RH_TraceSnapshot snapshot() {
+    RH_TraceSnapshot snapshot;
+    snapshot.originTicks = RH_TraceClock::originTicks();
+    snapshot.ticksPerMicroSecond = RH_TraceClock::ticksPerMicroSecond();
+
+    RH_TraceRing::forEach([&snapshot](const RH_TraceRing& ring) {
+      RH_TraceSnapshot::Thread thread;
+      thread.index = ring.threadIndex();
+      thread.overwritten = ring.copy(thread.events);
+      snapshot.threads.push_back(std::move(thread));
+    });
+    std::sort(snapshot.threads.begin(), snapshot.threads.end(),
+              [](const RH_TraceSnapshot::Thread& a,
+                 const RH_TraceSnapshot::Thread& b) {
+                return a.index < b.index;
+              });
+
+    RH_CodePoint::forEach([&snapshot](const RH_CodePoint& point) {
+      snapshot.codePoints.push_back(
+        {point.id(), point.line(), std::string(point.file()),
+         std::string(point.function())});
+    });
+    return snapshot;
+  }
+};
+
+#define RH__TRACE_CONCAT_(a, b) a ## b
+#define RH__TRACE_CONCAT(a, b) RH__TRACE_CONCAT_(a, b)
+
+#ifdef RH_USE_TRACE
+
+#define RH_TRACE(arg0, arg1)                                            \
+  (RH_TraceRing::writeLocal(RH_CODE_POINT_ID, RH_TraceEvent::instant,   \
+                            (arg0), (arg1)))
+
+#define RH_TRACE_SCOPE(arg0, arg1)                                      \
+  RH_TraceScope RH__TRACE_CONCAT(rhTraceScope, __LINE__)(               \
+    RH_CODE_POINT_ID, (arg0), (arg1))
+
+#else
+
+#define RH_TRACE(arg0, arg1) ((void)0)
+
+#define RH_TRACE_SCOPE(arg0, arg1) ((void)0)
+
+#endif // RH_USE_TRACE
+
+#endif // __RH_TRACE_hpp__
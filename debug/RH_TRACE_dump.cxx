@@ -0,0 +1,53 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+// compile: g++ -std=c++17 -O2 -Wall -I.. RH_TRACE_dump.cxx -o RH_TRACE_dump
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "RH_TRACE.hpp"
+
+// Decodes a RH_TraceSnapshot::writeBinary() file into Chrome trace /
+// Perfetto JSON:
+//
+//   RH_TRACE_dump trace.bin > trace.json
+
+int main(int argc, char **argv) {
+  if(argc != 2) {
+    std::cerr << "usage: " << argv[0] << " <trace snapshot file>"
+              << std::endl;
+    return 2;
+  }
+
+  std::ifstream file(argv[1], std::ios::binary);
+  if(!file) {
+    std::cerr << argv[0] << ": cannot open " << argv[1] << std::endl;
+    return 1;
+  }
+  std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)),
+                                  std::istreambuf_iterator<char>());
+
+  RH_TraceSnapshot snapshot;
+  try {
+    snapshot = RH_TraceSnapshot::readBinary(data.data(), data.size());
+  }
+  catch(const std::exception& exception) {
+    std::cerr << argv[0] << ": " << argv[1] << ": " << exception.what()
+              << std::endl;
+    return 1;
+  }
+  snapshot.writeChromeTrace(std::cout);
+
+  std::cerr << "events lost to ring overwrites:";
+  for(const RH_TraceSnapshot::Thread& thread : snapshot.threads) {
+    std::cerr << " thread " << thread.index << " " << thread.overwritten;
+  }
+  std::cerr << std::endl;
+  return 0;
+}
+
+// Emacs, here are file hints.
+// Local Variables:
+// compile-command: "g++ -std=c++17 -O2 -Wall -I.. RH_TRACE_dump.cxx -o RH_TRACE_dump"
+// End:
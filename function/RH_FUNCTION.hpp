@@ -0,0 +1,222 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+#ifndef __RH_FUNCTION_hpp__
+#define __RH_FUNCTION_hpp__
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Callables that never allocate:
+//
+// RH_InplaceFunction<R(Args...), Capacity> owns a callable like
+// std::function but keeps it in Capacity bytes inside the object; a
+// callable that does not fit does not compile. It is move only, so
+// callables holding move only state work too.
+//
+// RH_FunctionRef<R(Args...)> refers to a callable owned by someone else,
+// as a function parameter does; it is two pointers, copied by value, and
+// must not outlive what it refers to.
+//
+// Calling either when empty throws std::bad_function_call, as
+// std::function does. An empty RH_InplaceFunction, std::function or null
+// function pointer makes an empty RH_FunctionRef.
+
+#ifndef RH_INPLACE_FUNCTION_CAPACITY
+#define RH_INPLACE_FUNCTION_CAPACITY (4 * sizeof(void*))
+#endif
+
+template<typename Signature, size_t Capacity = RH_INPLACE_FUNCTION_CAPACITY>
+class RH_InplaceFunction;
+
+template<typename R, typename... Args, size_t Capacity>
+class RH_InplaceFunction<R(Args...), Capacity> {
+ public:
+  using Signature = R(Args...);
+  static constexpr size_t capacity = Capacity;
+
+  RH_InplaceFunction() noexcept = default;
+
+  RH_InplaceFunction(std::nullptr_t) noexcept {}
+
+  template<
+    typename F,
+    typename T = std::decay_t<F>,
+    typename = std::enable_if_t<
+      !std::is_same_v<T, RH_InplaceFunction> &&
+      std::is_invocable_r_v<R, T&, Args...>>
+  >
+  RH_InplaceFunction(F&& f) {
+    static_assert(sizeof(T) <= Capacity,
+                  "callable does not fit in RH_InplaceFunction Capacity");
+    static_assert(alignof(T) <= alignof(Storage),
+                  "callable is aligned stricter than RH_InplaceFunction");
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "RH_InplaceFunction needs a nothrow movable callable");
+    if constexpr(std::is_pointer_v<T>) {
+      if(!f) return;
+    }
+    ::new(static_cast<void*>(&storage_)) T(std::forward<F>(f));
+    operations_ = &operationsOf<T>;
+  }
+
+  RH_InplaceFunction(RH_InplaceFunction&& other) noexcept {
+    moveFrom(other);
+  }
+
+  RH_InplaceFunction& operator=(RH_InplaceFunction&& other) noexcept {
+    if(this != &other) {
+      reset();
+      moveFrom(other);
+    }
+    return *this;
+  }
+
+  RH_InplaceFunction& operator=(std::nullptr_t) noexcept {
+    reset();
+    return *this;
+  }
+
+  template<
+    typename F,
+    typename = std::enable_if_t<
+      !std::is_same_v<std::decay_t<F>, RH_InplaceFunction>>
+  >
+  RH_InplaceFunction& operator=(F&& f) {
+    return *this = RH_InplaceFunction(std::forward<F>(f));
+  }
+
+  RH_InplaceFunction(const RH_InplaceFunction&) = delete;
+  RH_InplaceFunction& operator=(const RH_InplaceFunction&) = delete;
+
+  ~RH_InplaceFunction() {
+    reset();
+  }
+
+  explicit operator bool() const noexcept {
+    return operations_ != nullptr;
+  }
+
+  R operator()(Args... args) const {
+    if(!operations_) throw std::bad_function_call();
+    return operations_->call(const_cast<Storage*>(&storage_),
+                             std::forward<Args>(args)...);
+  }
+
+ private:
+  using Storage = std::aligned_storage_t<Capacity, alignof(std::max_align_t)>;
+
+  struct Operations {
+    R (*call)(void* object, Args&&... args);
+    void (*move)(void* to, void* from) noexcept;
+    void (*destroy)(void* object) noexcept;
+  };
+
+  template<typename T>
+  static inline constexpr Operations operationsOf{
+    [](void* object, Args&&... args) -> R {
+      return std::invoke(*static_cast<T*>(object),
+                         std::forward<Args>(args)...);
+    },
+    [](void* to, void* from) noexcept {
+      ::new(to) T(std::move(*static_cast<T*>(from)));
+      static_cast<T*>(from)->~T();
+    },
+    [](void* object) noexcept {
+      static_cast<T*>(object)->~T();
+    }
+  };
+
+  void moveFrom(RH_InplaceFunction& other) noexcept {
+    if(other.operations_) {
+      other.operations_->move(&storage_, &other.storage_);
+      operations_ = other.operations_;
+      other.operations_ = nullptr;
+    }
+  }
+
+  void reset() noexcept {
+    if(operations_) {
+      operations_->destroy(&storage_);
+      operations_ = nullptr;
+    }
+  }
+
+  Storage storage_;
+  const Operations* operations_ = nullptr;
+};
+
+// Callable objects that test false when empty.
+template<typename T>
+struct RH__FunctionIsNullable : std::false_type {};
+
+template<typename S>
+struct RH__FunctionIsNullable<std::function<S>> : std::true_type {};
+
+template<typename S, size_t C>
+struct RH__FunctionIsNullable<RH_InplaceFunction<S, C>> : std::true_type {};
+
+template<typename Signature>
+class RH_FunctionRef;
+
+template<typename R, typename... Args>
+class RH_FunctionRef<R(Args...)> {
+ public:
+  using Signature = R(Args...);
+
+  RH_FunctionRef() noexcept = default;
+
+  RH_FunctionRef(std::nullptr_t) noexcept {}
+
+  template<
+    typename F,
+    typename T = std::remove_reference_t<F>,
+    typename = std::enable_if_t<
+      !std::is_same_v<std::remove_cv_t<T>, RH_FunctionRef> &&
+      std::is_invocable_r_v<R, T&, Args...>>
+  >
+  RH_FunctionRef(F&& f) noexcept {
+    using U = std::remove_cv_t<T>;
+    if constexpr(std::is_function_v<U> ||
+                 std::is_function_v<std::remove_pointer_t<U>>) {
+      // Functions are referred to by their address, not by where the
+      // caller keeps it.
+      using Function = std::add_pointer_t<std::remove_pointer_t<U>>;
+      const Function function = f;
+      if(!function) return;
+      object_ = reinterpret_cast<void*>(function);
+      call_ = [](void* object, Args&&... args) -> R {
+        return std::invoke(reinterpret_cast<Function>(object),
+                           std::forward<Args>(args)...);
+      };
+    }
+    else {
+      if constexpr(std::is_pointer_v<U> || std::is_member_pointer_v<U> ||
+                   RH__FunctionIsNullable<U>::value) {
+        if(!f) return;
+      }
+      object_ = const_cast<void*>(static_cast<const void*>(std::addressof(f)));
+      call_ = [](void* object, Args&&... args) -> R {
+        return std::invoke(*static_cast<T*>(object),
+                           std::forward<Args>(args)...);
+      };
+    }
+  }
+
+  explicit operator bool() const noexcept {
+    return call_ != nullptr;
+  }
+
+  R operator()(Args... args) const {
+    if(!call_) throw std::bad_function_call();
+    return call_(object_, std::forward<Args>(args)...);
+  }
+
+ private:
+  void* object_ = nullptr;
+  R (*call_)(void* object, Args&&... args) = nullptr;
+};
+
+#endif // __RH_FUNCTION_hpp__
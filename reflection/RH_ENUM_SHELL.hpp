@@ -4,8 +4,13 @@
 
 #include <iostream>
 
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
 #include <string>
-#include <vector>
+#include <string_view>
+#include <type_traits>
 
 #include "RH_FOR_EACH_P1.h"
 
@@ -59,6 +64,28 @@
 #define RH__ENUM_RENAMES(renamed, renames) \
   RH__ENUM_EXPAND(RH__ENUM_CAT(RH__ENUM_WHEN_, renamed)(renames))
 
+// Non-owning view of a static enum shell table (names, values or
+// indexes), as returned by itemNames(), itemIndexes() and itemsNames().
+template<typename T>
+class RH_EnumShellSpan {
+ public:
+  constexpr RH_EnumShellSpan() noexcept = default;
+  constexpr RH_EnumShellSpan(const T* data, size_t size) noexcept
+      : data_(data), size_(size)
+  {}
+  constexpr const T* data() const noexcept { return data_; }
+  constexpr size_t size() const noexcept { return size_; }
+  constexpr bool empty() const noexcept { return size_ == 0; }
+  constexpr const T* begin() const noexcept { return data_; }
+  constexpr const T* end() const noexcept { return data_ + size_; }
+  constexpr const T& operator [](size_t i) const noexcept {
+    return data_[i];
+  }
+ private:
+  const T* data_{nullptr};
+  size_t size_{0};
+};
+
 class RH_EnumShell {
  protected:
   static constexpr int
@@ -92,6 +119,519 @@ class RH_EnumShell {
     while(symbol[i] != '\0' && i < RH__ENUM_ITEM_NAME_LENGTH_MAX);
     return i;
   }
+
+  // Compile-time lookup tables. Enum shells build them once per enum in
+  // RH__EnumShellTables<Shell> (instantiated when the shell class is
+  // complete), so name and value lookups do not scan the items.
+
+  template<size_t N, typename F>
+  static constexpr auto itemTable(F item) noexcept {
+    std::array<decltype(item(0)), N> table{};
+    for(size_t i = 0; i < N; ++i) table[i] = item(static_cast<int>(i));
+    return table;
+  }
+
+  // FNV-1a
+  static constexpr uint32_t itemNameHash(std::string_view name) noexcept {
+    uint32_t hash = 2166136261u;
+    for(char c : name) {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+  static constexpr size_t itemNameHashTableSize(size_t itemsCount) noexcept {
+    size_t size = 1;
+    while(size < itemsCount * 2) size <<= 1;
+    return size;
+  }
+
+  // Open addressing with linear probing, at most 50% load. Holds item
+  // indexes; the first item with a given name wins.
+  template<size_t TableSize, size_t N>
+  static constexpr std::array<int, TableSize>
+  itemNameHashTable(const std::array<std::string_view, N>& names) noexcept {
+    std::array<int, TableSize> table{};
+    for(auto& slot : table) slot = -1;
+    for(size_t i = 0; i < N; ++i) {
+      size_t slot = itemNameHash(names[i]) & (TableSize - 1);
+      while(table[slot] >= 0 && names[table[slot]] != names[i]) {
+        slot = (slot + 1) & (TableSize - 1);
+      }
+      if(table[slot] < 0) table[slot] = static_cast<int>(i);
+    }
+    return table;
+  }
+
+  template<size_t TableSize, size_t N>
+  static constexpr int
+  itemNameHashLookup(const std::array<int, TableSize>& table,
+                     const std::array<std::string_view, N>& names,
+                     std::string_view name) noexcept
+  {
+    size_t slot = itemNameHash(name) & (TableSize - 1);
+    while(table[slot] >= 0) {
+      if(names[table[slot]] == name) return table[slot];
+      slot = (slot + 1) & (TableSize - 1);
+    }
+    return -1;
+  }
+
+  // Items grouped by value, each group in declaration order: group of
+  // item i is indexes/names [offsets[i], offsets[i] + sizes[i]).
+  template<size_t N>
+  struct ItemValueGroups {
+    std::array<int, N> indexes;
+    std::array<std::string_view, N> names;
+    std::array<int, N> offsets;
+    std::array<int, N> sizes;
+  };
+
+  template<typename ItemType, size_t N>
+  static constexpr ItemValueGroups<N>
+  itemValueGroupsBuild(const std::array<ItemType, N>& values,
+                       const std::array<std::string_view, N>& names) noexcept
+  {
+    ItemValueGroups<N> result{{}, {}, {}, {}};
+    for(auto& offset : result.offsets) offset = -1;
+    int next = 0;
+    for(size_t i = 0; i < N; ++i) {
+      if(result.offsets[i] >= 0) continue;
+      int offset = next;
+      for(size_t j = i; j < N; ++j) {
+        if(values[j] != values[i]) continue;
+        result.indexes[next] = static_cast<int>(j);
+        result.names[next] = names[j];
+        result.offsets[j] = offset;
+        ++next;
+      }
+      for(int k = offset; k < next; ++k) {
+        result.sizes[result.indexes[k]] = next - offset;
+      }
+    }
+    return result;
+  }
+
+  // Values spanning at most itemsCount * 2 + 64 consecutive integers get
+  // a dense (value - valueMin) -> index table; sparse values get an open
+  // addressing hash table like the names do.
+  template<size_t Size>
+  struct ItemValueIndexes {
+    bool dense;
+    long long valueMin;
+    std::array<int, Size> indexes;
+  };
+
+  template<typename ItemType>
+  static constexpr long long itemValueAsInteger(ItemType item) noexcept {
+    return static_cast<long long>(
+      static_cast<typename std::underlying_type<ItemType>::type>(item));
+  }
+
+  // Fibonacci hashing; TableSize is a power of two.
+  template<size_t TableSize>
+  static constexpr size_t itemValueHashSlot(long long value) noexcept {
+    return static_cast<size_t>(
+      (static_cast<unsigned long long>(value) * 0x9E3779B97F4A7C15ull)
+      >> 32) & (TableSize - 1);
+  }
+
+  template<typename ItemType, size_t N>
+  static constexpr bool
+  itemValuesDense(const std::array<ItemType, N>& values,
+                  long long& valueMin, size_t& valuesRange) noexcept
+  {
+    long long min = itemValueAsInteger(values[0]);
+    long long max = min;
+    for(ItemType value : values) {
+      long long v = itemValueAsInteger(value);
+      if(v < min) min = v;
+      if(v > max) max = v;
+    }
+    unsigned long long range = static_cast<unsigned long long>(max - min) + 1;
+    valueMin = min;
+    valuesRange = static_cast<size_t>(range);
+    return range <= N * 2 + 64;
+  }
+
+  template<typename ItemType, size_t N>
+  static constexpr size_t
+  itemValueIndexesSize(const std::array<ItemType, N>& values) noexcept {
+    long long valueMin = 0;
+    size_t valuesRange = 0;
+    return itemValuesDense(values, valueMin, valuesRange) ?
+      valuesRange : itemNameHashTableSize(N);
+  }
+
+  template<size_t Size, typename ItemType, size_t N>
+  static constexpr ItemValueIndexes<Size>
+  itemValueIndexesBuild(const std::array<ItemType, N>& values) noexcept {
+    ItemValueIndexes<Size> result{false, 0, {}};
+    size_t valuesRange = 0;
+    result.dense = itemValuesDense(values, result.valueMin, valuesRange);
+    for(auto& index : result.indexes) index = -1;
+    for(size_t i = 0; i < N; ++i) {
+      long long v = itemValueAsInteger(values[i]);
+      size_t slot = result.dense ?
+        static_cast<size_t>(v - result.valueMin) : itemValueHashSlot<Size>(v);
+      if(!result.dense) {
+        while(result.indexes[slot] >= 0 &&
+              values[result.indexes[slot]] != values[i]) {
+          slot = (slot + 1) & (Size - 1);
+        }
+      }
+      if(result.indexes[slot] < 0) result.indexes[slot] = static_cast<int>(i);
+    }
+    return result;
+  }
+
+  template<size_t Size, typename ItemType, size_t N>
+  static constexpr int
+  itemValueIndexLookup(const ItemValueIndexes<Size>& valueIndexes,
+                       const std::array<ItemType, N>& values,
+                       ItemType item) noexcept
+  {
+    long long v = itemValueAsInteger(item);
+    if(valueIndexes.dense) {
+      if(v < valueIndexes.valueMin) return -1;
+      unsigned long long offset =
+        static_cast<unsigned long long>(v - valueIndexes.valueMin);
+      if(offset >= Size) return -1;
+      return valueIndexes.indexes[offset];
+    }
+    size_t slot = itemValueHashSlot<Size>(v);
+    while(valueIndexes.indexes[slot] >= 0) {
+      if(values[valueIndexes.indexes[slot]] == item) {
+        return valueIndexes.indexes[slot];
+      }
+      slot = (slot + 1) & (Size - 1);
+    }
+    return -1;
+  }
+};
+
+// Lookup tables of an enum shell. At namespace scope rather than
+// nested, as local classes may not have member templates, so shells can
+// still be declared in function bodies.
+template<typename Shell>
+struct RH__EnumShellTables : RH_EnumShell {
+  static constexpr auto values =
+    itemTable<Shell::itemsCount()>(&Shell::itemValueCompute);
+  static constexpr auto valueIndexes =
+    itemValueIndexesBuild<itemValueIndexesSize(values)>(values);
+  static constexpr auto names =
+    itemTable<Shell::itemsCount()>(&Shell::itemNameCompute);
+  static constexpr auto nameIndexes =
+    itemNameHashTable<itemNameHashTableSize(Shell::itemsCount())>(names);
+  static constexpr auto valueGroups = itemValueGroupsBuild(values, names);
+};
+
+// Bit set of enum shell items, one bit per item index. Items sharing a
+// value share the bit of the first of them, so iteration (lowest bit
+// first via count trailing zeros) follows declaration order.
+template<typename Shell>
+class RH_EnumSet {
+ public:
+  using Item = typename std::decay<decltype(Shell::itemValue(0))>::type;
+  using Word = uint64_t;
+
+  static constexpr size_t wordBits = 64;
+  static constexpr size_t wordsCount =
+    (static_cast<size_t>(Shell::itemsCount()) + wordBits - 1) / wordBits;
+
+  class Iterator {
+   public:
+    constexpr Iterator(const RH_EnumSet* set, size_t wordIndex) noexcept
+        : set_(set), wordIndex_(wordIndex),
+          word_(wordIndex < wordsCount ? set->words_[wordIndex] : 0)
+    {
+      skipEmptyWords();
+    }
+    constexpr Item operator *() const noexcept {
+      return Shell::itemsValues()[index()];
+    }
+    constexpr int index() const noexcept {
+      return static_cast<int>(
+        wordIndex_ * wordBits + countTrailingZeros(word_));
+    }
+    constexpr Iterator& operator ++() noexcept {
+      word_ &= word_ - 1;
+      skipEmptyWords();
+      return *this;
+    }
+    constexpr bool operator ==(const Iterator& other) const noexcept {
+      return wordIndex_ == other.wordIndex_ && word_ == other.word_;
+    }
+    constexpr bool operator !=(const Iterator& other) const noexcept {
+      return !(*this == other);
+    }
+   private:
+    constexpr void skipEmptyWords() noexcept {
+      while(word_ == 0 && wordIndex_ < wordsCount) {
+        ++wordIndex_;
+        if(wordIndex_ < wordsCount) word_ = set_->words_[wordIndex_];
+      }
+    }
+    const RH_EnumSet* set_;
+    size_t wordIndex_;
+    Word word_;
+  };
+
+  constexpr RH_EnumSet() noexcept = default;
+
+  constexpr RH_EnumSet(std::initializer_list<Item> items) noexcept {
+    for(Item item : items) insert(item);
+  }
+
+  static constexpr RH_EnumSet all() noexcept {
+    RH_EnumSet result;
+    result.words_ = validWords();
+    return result;
+  }
+
+  constexpr bool contains(Item item) const noexcept {
+    int index = Shell::itemIndex(item);
+    return index >= 0 &&
+      (words_[index / wordBits] >> (index % wordBits) & 1) != 0;
+  }
+
+  constexpr RH_EnumSet& insert(Item item) noexcept {
+    int index = Shell::itemIndex(item);
+    if(index >= 0) words_[index / wordBits] |= Word{1} << (index % wordBits);
+    return *this;
+  }
+
+  constexpr RH_EnumSet& erase(Item item) noexcept {
+    int index = Shell::itemIndex(item);
+    if(index >= 0) {
+      words_[index / wordBits] &= ~(Word{1} << (index % wordBits));
+    }
+    return *this;
+  }
+
+  constexpr void clear() noexcept {
+    for(Word& word : words_) word = 0;
+  }
+
+  constexpr bool empty() const noexcept {
+    for(Word word : words_) if(word != 0) return false;
+    return true;
+  }
+
+  constexpr size_t size() const noexcept {
+    size_t result = 0;
+    for(Word word : words_) result += populationCount(word);
+    return result;
+  }
+
+  constexpr Iterator begin() const noexcept { return Iterator(this, 0); }
+  constexpr Iterator end() const noexcept {
+    return Iterator(this, wordsCount);
+  }
+
+  constexpr RH_EnumSet& operator |=(const RH_EnumSet& other) noexcept {
+    for(size_t i = 0; i < wordsCount; ++i) words_[i] |= other.words_[i];
+    return *this;
+  }
+
+  constexpr RH_EnumSet& operator &=(const RH_EnumSet& other) noexcept {
+    for(size_t i = 0; i < wordsCount; ++i) words_[i] &= other.words_[i];
+    return *this;
+  }
+
+  constexpr RH_EnumSet& operator ^=(const RH_EnumSet& other) noexcept {
+    for(size_t i = 0; i < wordsCount; ++i) words_[i] ^= other.words_[i];
+    return *this;
+  }
+
+  constexpr RH_EnumSet& operator -=(const RH_EnumSet& other) noexcept {
+    for(size_t i = 0; i < wordsCount; ++i) words_[i] &= ~other.words_[i];
+    return *this;
+  }
+
+  constexpr RH_EnumSet operator ~() const noexcept {
+    RH_EnumSet result = all();
+    return result -= *this;
+  }
+
+  friend constexpr RH_EnumSet
+  operator |(RH_EnumSet lhs, const RH_EnumSet& rhs) noexcept {
+    return lhs |= rhs;
+  }
+
+  friend constexpr RH_EnumSet
+  operator &(RH_EnumSet lhs, const RH_EnumSet& rhs) noexcept {
+    return lhs &= rhs;
+  }
+
+  friend constexpr RH_EnumSet
+  operator ^(RH_EnumSet lhs, const RH_EnumSet& rhs) noexcept {
+    return lhs ^= rhs;
+  }
+
+  friend constexpr RH_EnumSet
+  operator -(RH_EnumSet lhs, const RH_EnumSet& rhs) noexcept {
+    return lhs -= rhs;
+  }
+
+  constexpr bool operator ==(const RH_EnumSet& other) const noexcept {
+    for(size_t i = 0; i < wordsCount; ++i) {
+      if(words_[i] != other.words_[i]) return false;
+    }
+    return true;
+  }
+
+  constexpr bool operator !=(const RH_EnumSet& other) const noexcept {
+    return !(*this == other);
+  }
+
+  constexpr const std::array<Word, wordsCount>& words() const noexcept {
+    return words_;
+  }
+
+ private:
+  static constexpr size_t countTrailingZeros(Word word) noexcept {
+#if defined(__GNUC__)
+    return static_cast<size_t>(__builtin_ctzll(word));
+#else
+    size_t result = 0;
+    while((word & 1) == 0) { word >>= 1; ++result; }
+    return result;
+#endif
+  }
+
+  static constexpr size_t populationCount(Word word) noexcept {
+#if defined(__GNUC__)
+    return static_cast<size_t>(__builtin_popcountll(word));
+#else
+    size_t result = 0;
+    for(; word != 0; word &= word - 1) ++result;
+    return result;
+#endif
+  }
+
+  // Bits of the first item of each value.
+  static constexpr std::array<Word, wordsCount> validWords() noexcept {
+    std::array<Word, wordsCount> result{};
+    for(int i = 0; i < Shell::itemsCount(); ++i) {
+      if(Shell::itemIndex(Shell::itemsValues()[i]) == i) {
+        result[i / wordBits] |= Word{1} << (i % wordBits);
+      }
+    }
+    return result;
+  }
+
+  std::array<Word, wordsCount> words_{};
+};
+
+// Array of V with one slot per enum shell item value, iterated in
+// declaration order. Items sharing a value share the slot. Values that
+// are no item share a spare slot for operator [], which stays in bounds;
+// at() throws for them.
+// Unlike EnumSet, shells have no EnumMap member, as an alias template
+// would keep them out of function bodies: RH_EnumMap<Shell, int> counts.
+template<typename Shell, typename V>
+class RH_EnumMap {
+ public:
+  using Item = typename std::decay<decltype(Shell::itemValue(0))>::type;
+  using Value = V;
+
+  template<typename MapValue>
+  struct Entry {
+    Item item;
+    std::string_view name;
+    MapValue& value;
+  };
+
+  template<typename Map, typename MapValue>
+  class Iterator {
+   public:
+    constexpr Iterator(Map* map, int index) noexcept
+        : map_(map), index_(index)
+    {
+      skipAliases();
+    }
+    constexpr Entry<MapValue> operator *() const noexcept {
+      return {Shell::itemsValues()[index_],
+              Shell::itemsNames()[index_],
+              map_->values_[index_]};
+    }
+    constexpr Iterator& operator ++() noexcept {
+      ++index_;
+      skipAliases();
+      return *this;
+    }
+    constexpr bool operator ==(const Iterator& other) const noexcept {
+      return index_ == other.index_;
+    }
+    constexpr bool operator !=(const Iterator& other) const noexcept {
+      return index_ != other.index_;
+    }
+   private:
+    constexpr void skipAliases() noexcept {
+      while(index_ < Shell::itemsCount() &&
+            Shell::itemIndex(Shell::itemsValues()[index_]) != index_) {
+        ++index_;
+      }
+    }
+    Map* map_;
+    int index_;
+  };
+
+  constexpr RH_EnumMap() = default;
+
+  constexpr explicit RH_EnumMap(const Value& value) {
+    fill(value);
+  }
+
+  constexpr void fill(const Value& value) {
+    for(Value& v : values_) v = value;
+  }
+
+  constexpr Value& operator [](Item item) noexcept {
+    return values_[slotIndex(item)];
+  }
+
+  constexpr const Value& operator [](Item item) const noexcept {
+    return values_[slotIndex(item)];
+  }
+
+  constexpr Value& at(Item item) {
+    int index = Shell::itemIndex(item);
+    if(index < 0) throw std::out_of_range("Invalid enum item");
+    return values_[index];
+  }
+
+  constexpr const Value& at(Item item) const {
+    int index = Shell::itemIndex(item);
+    if(index < 0) throw std::out_of_range("Invalid enum item");
+    return values_[index];
+  }
+
+  constexpr Iterator<RH_EnumMap, Value> begin() noexcept {
+    return {this, 0};
+  }
+  constexpr Iterator<RH_EnumMap, Value> end() noexcept {
+    return {this, Shell::itemsCount()};
+  }
+  constexpr Iterator<const RH_EnumMap, const Value> begin() const noexcept {
+    return {this, 0};
+  }
+  constexpr Iterator<const RH_EnumMap, const Value> end() const noexcept {
+    return {this, Shell::itemsCount()};
+  }
+
+ private:
+  static constexpr size_t spareIndex =
+    static_cast<size_t>(Shell::itemsCount());
+
+  static constexpr size_t slotIndex(Item item) noexcept {
+    const int index = Shell::itemIndex(item);
+    return index < 0 ? spareIndex : static_cast<size_t>(index);
+  }
+
+  std::array<Value, spareIndex + 1> values_{};
 };
 
 #define RH__ENUM_SHELL(RH__EnumShellName, withClass,                    \
@@ -112,6 +652,38 @@ class RH_EnumShell {
      private:                                                           \
       ItemType item_;                                                   \
     };                                                                  \
+    static constexpr ItemType                                           \
+    itemValueCompute(int ItemType ## _index) noexcept {                 \
+      enum RH__ENUM_TYPE(itemUTyped, ItemUType) { __VA_ARGS__ };        \
+      constexpr ItemType ItemType ## _array[] {                         \
+        RH__ENUM_PROXIFY_LIST(ItemType ## Proxy, __VA_ARGS__)           \
+      };                                                                \
+      return ItemType ## _array[ItemType ## _index];                    \
+    }                                                                   \
+    static constexpr const char* itemSymbol(int index) noexcept {       \
+      constexpr const char* itemSymbols[] {                             \
+        RH__ENUM_STRINGIFY_LIST(__VA_ARGS__)                            \
+      };                                                                \
+      return itemSymbols[index];                                        \
+    }                                                                   \
+    static constexpr std::string_view                                   \
+    itemRenamed(std::string_view name) noexcept {                       \
+      constexpr struct {                                                \
+        const char* key;                                                \
+        const char* value;                                              \
+      } renames[] = { RH__ENUM_RENAMES(itemsRenamed, itemRenames) };    \
+      for(const auto& rename : renames)                                 \
+        if(name == rename.key) return rename.value;                     \
+      return name;                                                      \
+    }                                                                   \
+    static constexpr std::string_view                                   \
+    itemNameCompute(int index) noexcept {                               \
+      const char* symbol = itemSymbol(index);                           \
+      return itemRenamed(                                               \
+        std::string_view(symbol, itemNameLength(symbol)));              \
+    }                                                                   \
+    friend struct ::RH__EnumShellTables<RH__EnumShellName>;             \
+    using ItemType ## Tables = RH__EnumShellTables<RH__EnumShellName>;  \
    public:                                                              \
     static constexpr const char* itemsScopeName() noexcept  {           \
       return RH__ENUM_STRINGIFY(ItemType);                              \
@@ -125,47 +697,58 @@ class RH_EnumShell {
       };                                                                \
       return sizeof(itemSymbols) / sizeof(itemSymbols[0]);              \
     }                                                                   \
-    static std::string itemName(int index) {                            \
-      if(index < 0 || index >= itemsCount()) return std::string();      \
-      const char* symbol = itemSymbol(index);                           \
-      const char* name = itemRenamed(symbol);                           \
-      if(symbol == name) {                                              \
-        size_t nameLength = itemNameLength(name);                       \
-        return std::string(name, nameLength);                           \
-      }                                                                 \
-      else return std::string(name);                                    \
+    static constexpr std::string_view itemName(int index) noexcept {    \
+      if(index < 0 || index >= itemsCount()) return std::string_view(); \
+      return ItemType ## Tables::names[index];                          \
     }                                                                   \
-    static std::string itemName(ItemType item) {                        \
+    static constexpr std::string_view                                   \
+    itemName(ItemType item) noexcept {                                  \
       return itemName(itemIndex(item));                                 \
     }                                                                   \
-    static std::vector<std::string> itemNames(ItemType item) {          \
-      decltype(itemNames(item)) result;                                 \
-      for(int i = 0; i < itemsCount(); ++i) {                           \
-        if(itemValueNoRangeCheck(i) == item)                            \
-          result.push_back(itemName(i));                                \
-      }                                                                 \
-      return result;                                                    \
+    static constexpr RH_EnumShellSpan<std::string_view>                 \
+    itemNames(ItemType item) noexcept {                                 \
+      using Tables = ItemType ## Tables;                                \
+      int index = itemIndex(item);                                      \
+      if(index < 0) return {};                                          \
+      return {&Tables::valueGroups.names[                               \
+                Tables::valueGroups.offsets[index]],                    \
+              static_cast<size_t>(Tables::valueGroups.sizes[index])};   \
+    }                                                                   \
+    static constexpr RH_EnumShellSpan<std::string_view>                 \
+    itemsNames() noexcept {                                             \
+      using Tables = ItemType ## Tables;                                \
+      return {Tables::names.data(), Tables::names.size()};              \
+    }                                                                   \
+    static constexpr RH_EnumShellSpan<ItemType>                         \
+    itemsValues() noexcept {                                            \
+      using Tables = ItemType ## Tables;                                \
+      return {Tables::values.data(), Tables::values.size()};            \
+    }                                                                   \
+    using EnumSet = RH_EnumSet<RH__EnumShellName>;                      \
+    static constexpr int itemIndex(std::string_view name) noexcept {    \
+      using Tables = ItemType ## Tables;                                \
+      return itemNameHashLookup(                                        \
+        Tables::nameIndexes, Tables::names, name);                      \
     }                                                                   \
     static constexpr int itemIndex(const char* name) noexcept {         \
-      for(int i = 0; i < itemsCount(); ++i) {                           \
-        const char* rsymbol = itemRenamed(itemSymbol(i));               \
-        if(itemBeginsWithName(rsymbol, name)) return i;                 \
-      }                                                                 \
-      return -1;                                                        \
+      return itemIndex(std::string_view(name));                         \
+    }                                                                   \
+    static int itemIndex(const std::string& name) noexcept {            \
+      return itemIndex(std::string_view(name));                         \
     }                                                                   \
     static constexpr int itemIndex(ItemType item) noexcept {            \
-      for(int i = 0; i < itemsCount(); ++i) {                           \
-        if(itemValueNoRangeCheck(i) == item) return i;                  \
-      }                                                                 \
-      return -1;                                                        \
+      using Tables = ItemType ## Tables;                                \
+      return itemValueIndexLookup(                                      \
+        Tables::valueIndexes, Tables::values, item);                    \
     }                                                                   \
-    static std::vector<int> itemIndexes(ItemType item)                  \
-    {                                                                   \
-      decltype(itemIndexes(item)) result;                               \
-      for(int i = 0; i < itemsCount(); ++i) {                           \
-        if(itemValueNoRangeCheck(i) == item) result.push_back(i);       \
-      }                                                                 \
-      return result;                                                    \
+    static constexpr RH_EnumShellSpan<int>                              \
+    itemIndexes(ItemType item) noexcept {                               \
+      using Tables = ItemType ## Tables;                                \
+      int index = itemIndex(item);                                      \
+      if(index < 0) return {};                                          \
+      return {&Tables::valueGroups.indexes[                             \
+                Tables::valueGroups.offsets[index]],                    \
+              static_cast<size_t>(Tables::valueGroups.sizes[index])};   \
     }                                                                   \
     static constexpr ItemType itemValue(int index) {                    \
       if(index < 0 || index >= itemsCount()) {                          \
@@ -173,84 +756,86 @@ class RH_EnumShell {
       }                                                                 \
       return itemValueNoRangeCheck(index);                              \
     }                                                                   \
-    static constexpr ItemType itemValue(const char* name) {             \
+    static constexpr ItemType itemValue(std::string_view name) {        \
       int index = itemIndex(name);                                      \
       if(index < 0) {                                                   \
         itemThrowInvalidArgument("Invalid enum name");                  \
       }                                                                 \
       return itemValueNoRangeCheck(index);                              \
     }                                                                   \
+    static constexpr ItemType itemValue(const char* name) {             \
+      return itemValue(std::string_view(name));                         \
+    }                                                                   \
+    static ItemType itemValue(const std::string& name) {                \
+      return itemValue(std::string_view(name));                         \
+    }                                                                   \
     constexpr RH__EnumShellName(ItemType item = itemValue(0)) noexcept  \
         : item_(item)                                                   \
     {}                                                                  \
+    constexpr RH__EnumShellName(std::string_view name)                  \
+        : item_(itemValue(name))                                        \
+    {}                                                                  \
     constexpr RH__EnumShellName(const char* name)                       \
         : item_(itemValue(name))                                        \
     {}                                                                  \
     RH__EnumShellName(const std::string& name)                          \
-        : item_(itemValue(name.c_str()))                                \
+        : item_(itemValue(name))                                        \
     {}                                                                  \
     constexpr RH__EnumShellName& operator =(ItemType item) noexcept {   \
       item_ = item; return *this;                                       \
     }                                                                   \
-    constexpr RH__EnumShellName& operator =(const char* name) {         \
+    constexpr RH__EnumShellName& operator =(std::string_view name) {    \
       item_ = itemValue(name); return *this;                            \
     }                                                                   \
+    constexpr RH__EnumShellName& operator =(const char* name) {         \
+      return this->operator =(std::string_view(name));                  \
+    }                                                                   \
     RH__EnumShellName& operator =(const std::string& name) {            \
-      return this->operator =(name.c_str());                            \
+      return this->operator =(std::string_view(name));                  \
     }                                                                   \
-    constexpr bool operator ==(const char* name) const {                \
+    constexpr bool operator ==(std::string_view name) const {           \
       return item_ == itemValue(name);                                  \
     }                                                                   \
+    constexpr bool operator ==(const char* name) const {                \
+      return this->operator ==(std::string_view(name));                 \
+    }                                                                   \
     bool operator ==(const std::string& name) const {                   \
-      return this->operator ==(name.c_str());                           \
+      return this->operator ==(std::string_view(name));                 \
     }                                                                   \
-    constexpr bool operator !=(const char* name) const {                \
+    constexpr bool operator !=(std::string_view name) const {           \
       return !(item_ == itemValue(name));                               \
     }                                                                   \
+    constexpr bool operator !=(const char* name) const {                \
+      return this->operator !=(std::string_view(name));                 \
+    }                                                                   \
     bool operator !=(const std::string& name) const {                   \
-      return this->operator !=(name.c_str());                           \
+      return this->operator !=(std::string_view(name));                 \
     }                                                                   \
     constexpr operator ItemType() const { return itemValue(); }         \
     constexpr ItemType itemValue() const noexcept { return item_; }     \
-    constexpr bool itemName(const char* name) noexcept {                \
+    constexpr bool itemName(std::string_view name) noexcept {           \
       int index = itemIndex(name);                                      \
       if(index < 0) return false;                                       \
       item_ = itemValueNoRangeCheck(index);                             \
       return true;                                                      \
     }                                                                   \
+    constexpr bool itemName(const char* name) noexcept {                \
+      return itemName(std::string_view(name));                          \
+    }                                                                   \
     bool itemName(const std::string& name) noexcept {                   \
-      return itemName(name.c_str());                                    \
+      return itemName(std::string_view(name));                          \
     }                                                                   \
-    std::string itemName() const {                                      \
+    constexpr std::string_view itemName() const noexcept {              \
       return RH__EnumShellName::itemName(item_);                        \
     }                                                                   \
-    std::vector<std::string> itemNames() const {                        \
+    constexpr RH_EnumShellSpan<std::string_view>                        \
+    itemNames() const noexcept {                                        \
       return RH__EnumShellName::itemNames(item_);                       \
     }                                                                   \
    private:                                                             \
     static constexpr ItemType                                           \
-    itemValueNoRangeCheck(int ItemType ## _index) noexcept {            \
-      enum RH__ENUM_TYPE(itemUTyped, ItemUType) { __VA_ARGS__ };        \
-      constexpr ItemType ItemType ## _array[] {                         \
-        RH__ENUM_PROXIFY_LIST(ItemType ## Proxy, __VA_ARGS__)           \
-      };                                                                \
-      return ItemType ## _array[ItemType ## _index];                    \
-    }                                                                   \
-    static constexpr const char* itemSymbol(int index) noexcept {       \
-      constexpr const char* itemSymbols[] {                             \
-        RH__ENUM_STRINGIFY_LIST(__VA_ARGS__)                            \
-      };                                                                \
-      return itemSymbols[index];                                        \
-    }                                                                   \
-    static constexpr const char*                                        \
-    itemRenamed(const char* symbol) noexcept {                          \
-      constexpr struct {                                                \
-        const char* key;                                                \
-        const char* value;                                              \
-      } renames[] = { RH__ENUM_RENAMES(itemsRenamed, itemRenames) };    \
-      for(const auto& rename : renames)                                 \
-        if(itemBeginsWithName(symbol, rename.key)) return rename.value; \
-      return symbol;                                                    \
+    itemValueNoRangeCheck(int index) noexcept {                         \
+      return ItemType ## Tables::values[index];                         \
     }                                                                   \
     static constexpr void itemThrowInvalidArgument(const char* what) {  \
       what[0] != '\0' ? throw std::invalid_argument(what) : 0;          \
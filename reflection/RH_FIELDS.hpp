@@ -0,0 +1,243 @@
+// Hey Emacs, this is -*- coding: utf-8 mode: c++ -*-
+#ifndef __RH_FIELDS_hpp__
+#define __RH_FIELDS_hpp__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "RH_FOR_EACH.h"
+#include "RH_STRINGIFY.h"
+
+// Compile-time field descriptors generated from an RH_FOR_EACH field
+// list, e.g.
+//
+//   class Probe {
+//     int m_count;
+//     double m_value;
+//     std::string m_label;
+//
+//     RH_FIELDS(Probe, m_count, m_value, m_label)
+//   };
+//
+// RH_Fields<Probe>::descriptors() is then a constexpr std::tuple of
+// RH_Field<Probe, T> (name, member pointer, offset), in declaration
+// order, for serializers to walk without any run-time registration.
+
+template<typename C, typename T>
+struct RH_Field {
+  using Class = C;
+  using Type = T;
+
+  // offset is only known for standard layout classes.
+  static constexpr size_t noOffset = static_cast<size_t>(-1);
+
+  std::string_view name;
+  T C::* member;
+  size_t offset;
+
+  constexpr T& get(C& object) const noexcept {
+    return object.*member;
+  }
+
+  constexpr const T& get(const C& object) const noexcept {
+    return object.*member;
+  }
+};
+
+template<typename T>
+class RH_Fields;
+
+template<typename T, typename = void>
+struct RH_IsReflected : std::false_type {};
+
+template<typename T>
+struct RH_IsReflected<
+  T,
+  std::void_t<decltype(RH_Fields<T>::descriptorsOf(static_cast<T*>(nullptr)))>
+> : std::true_type {};
+
+template<typename T>
+struct RH_IsVector : std::false_type {};
+
+template<typename E, typename A>
+struct RH_IsVector<std::vector<E, A>> : std::true_type {};
+
+template<typename T>
+struct RH_IsStdArray : std::false_type {};
+
+template<typename E, size_t N>
+struct RH_IsStdArray<std::array<E, N>> : std::true_type {};
+
+// Types whose bytes all belong to the value, so memcpy copies no padding
+// of indeterminate value. long double has padding on x86.
+template<typename T>
+struct RH_IsPadFree
+    : std::integral_constant<
+        bool,
+        std::has_unique_object_representations<T>::value ||
+        (std::is_arithmetic<T>::value &&
+         !std::is_same<T, long double>::value)> {};
+
+template<typename E, size_t N>
+struct RH_IsPadFree<E[N]> : RH_IsPadFree<E> {};
+
+template<typename E, size_t N>
+struct RH_IsPadFree<std::array<E, N>>
+    : std::integral_constant<
+        bool,
+        RH_IsPadFree<E>::value && sizeof(std::array<E, N>) == N * sizeof(E)>
+{};
+
+template<typename T>
+class RH_Fields {
+ public:
+  // Only usable in unevaluated context, for RH_IsReflected<T>
+  template<typename U = T>
+  static auto descriptorsOf(U*) -> decltype(U::rhFields());
+
+  static constexpr auto descriptors() noexcept {
+    return T::rhFields();
+  }
+
+  static constexpr size_t count() noexcept {
+    return std::tuple_size<decltype(descriptors())>::value;
+  }
+
+  static constexpr const char* className() noexcept {
+    return T::rhFieldsClassName();
+  }
+
+  template<typename F>
+  static constexpr void forEach(F&& f) {
+    std::apply([&f](const auto&... field) { (f(field), ...); },
+               descriptors());
+  }
+
+  // Hash of field names and field type structure (not type names), so
+  // writers and readers can reject snapshots of a different layout.
+  static constexpr uint64_t schemaHash() noexcept {
+    uint64_t hash = hashString(14695981039346656037ull, className());
+    forEach([&hash](const auto& field) {
+      hash = hashString(hash, field.name);
+      hash = hashType<typename std::decay_t<decltype(field)>::Type>(hash);
+    });
+    return hash;
+  }
+
+  // For each field index, the end of the run of fields that starts with
+  // it and can be copied with one memcpy: RH_IsPadFree fields laid out
+  // back to back. A run of any other field ends at the field itself.
+  static constexpr auto trivialRunEnds() noexcept {
+    std::array<size_t, count()> offsets{};
+    std::array<size_t, count()> sizes{};
+    std::array<bool, count()> trivial{};
+    size_t i = 0;
+    forEach([&](const auto& field) {
+      using Type = typename std::decay_t<decltype(field)>::Type;
+      offsets[i] = field.offset;
+      sizes[i] = sizeof(Type);
+      trivial[i] = RH_IsPadFree<Type>::value &&
+                   field.offset != field.noOffset;
+      ++i;
+    });
+    std::array<size_t, count()> ends{};
+    for(size_t j = count(); j-- > 0;) {
+      ends[j] = j + 1;
+      if(trivial[j] && j + 1 < count() && trivial[j + 1] &&
+         offsets[j] + sizes[j] == offsets[j + 1]) {
+        ends[j] = ends[j + 1];
+      }
+    }
+    return ends;
+  }
+
+  static constexpr uint64_t
+  hashString(uint64_t hash, std::string_view s) noexcept {
+    for(char c : s) {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ull;
+    }
+    hash ^= 0xff;
+    hash *= 1099511628211ull;
+    return hash;
+  }
+
+  static constexpr uint64_t hashTag(uint64_t hash, uint64_t tag) noexcept {
+    for(int i = 0; i < 8; ++i) {
+      hash ^= (tag >> (i * 8)) & 0xff;
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  template<typename U>
+  static constexpr uint64_t hashType(uint64_t hash) noexcept {
+    if constexpr(RH_IsReflected<U>::value) {
+      hash = hashTag(hash, 'r');
+      RH_Fields<U>::forEach([&hash](const auto& field) {
+        hash = hashString(hash, field.name);
+        hash = hashType<typename std::decay_t<decltype(field)>::Type>(hash);
+      });
+      return hash;
+    }
+    else if constexpr(std::is_same<U, std::string>::value) {
+      return hashTag(hash, 's');
+    }
+    else if constexpr(RH_IsVector<U>::value) {
+      return hashType<typename U::value_type>(hashTag(hash, 'v'));
+    }
+    else if constexpr(RH_IsStdArray<U>::value) {
+      hash = hashTag(hashTag(hash, 'a'), std::tuple_size<U>::value);
+      return hashType<typename U::value_type>(hash);
+    }
+    else if constexpr(std::is_same<U, bool>::value) {
+      return hashTag(hash, 'b');
+    }
+    else if constexpr(std::is_floating_point<U>::value) {
+      return hashTag(hashTag(hash, 'f'), sizeof(U));
+    }
+    else if constexpr(std::is_integral<U>::value) {
+      return hashTag(
+        hashTag(hash, std::is_signed<U>::value ? 'i' : 'u'), sizeof(U));
+    }
+    else if constexpr(std::is_enum<U>::value) {
+      return hashTag(hashTag(hash, 'e'), sizeof(U));
+    }
+    else {
+      static_assert(std::is_trivially_copyable<U>::value,
+                    "RH_FIELDS: unsupported field type");
+      return hashTag(hashTag(hash, 't'), sizeof(U));
+    }
+  }
+};
+
+#define RH__FIELD_DESCRIPTOR(field)                                     \
+  std::make_tuple(RH_Field<RH__Self, decltype(RH__Self::field)>{        \
+    RH__STRINGIFY(field), &RH__Self::field,                             \
+    [] {                                                                \
+      if constexpr(std::is_standard_layout<RH__Self>::value)            \
+        return offsetof(RH__Self, field);                               \
+      else return static_cast<size_t>(-1);                              \
+    }()                                                                 \
+  }),
+
+#define RH_FIELDS(RH__ClassName, ...)                                   \
+  template<typename RH__Self = RH__ClassName>                           \
+  static constexpr auto rhFields() noexcept {                           \
+    return std::tuple_cat(                                              \
+      RH_FOR_EACH(RH__FIELD_DESCRIPTOR, __VA_ARGS__) std::tuple<>());   \
+  }                                                                     \
+  static constexpr const char* rhFieldsClassName() noexcept {           \
+    return RH__STRINGIFY(RH__ClassName);                                \
+  }                                                                     \
+  friend class RH_Fields<RH__ClassName>;
+//#define RH_FIELDS
+
+#endif //__RH_FIELDS_hpp__
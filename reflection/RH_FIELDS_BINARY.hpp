@@ -0,0 +1,264 @@
+// Hey Emacs, this is -*- coding: utf-8 mode: c++ -*-
+#ifndef __RH_FIELDS_BINARY_hpp__
+#define __RH_FIELDS_BINARY_hpp__
+
+#include <cstring>
+#include <stdexcept>
+
+#include "RH_FIELDS.hpp"
+
+// Binary snapshots of RH_FIELDS reflected classes.
+//
+// A record is the 64-bit RH_Fields<T>::schemaHash() followed by the
+// fields in declaration order. Runs of back to back RH_IsPadFree fields
+// are copied with one memcpy; std::string and std::vector are prefixed
+// with their uint64_t size (vectors of RH_IsPadFree elements are then
+// copied with one memcpy too). Padding is never written, so snapshots of
+// equal objects are equal; other classes with padding must use RH_FIELDS.
+// Everything is in host byte order - the format is for snapshots read
+// back on the same kind of host, not for exchange.
+
+class RH_BinaryWriter {
+ public:
+  using Buffer = std::vector<unsigned char>;
+
+  explicit RH_BinaryWriter(Buffer& buffer)
+      : buffer_(buffer)
+  {}
+
+  template<typename T>
+  void write(const T& object) {
+    static_assert(RH_IsReflected<T>::value,
+                  "RH_BinaryWriter: T must use RH_FIELDS");
+    constexpr uint64_t schemaHash = RH_Fields<T>::schemaHash();
+    writeTrivial(schemaHash);
+    writeValue(object);
+  }
+
+ private:
+  void writeBytes(const void* data, size_t size) {
+    size_t position = buffer_.size();
+    buffer_.resize(position + size);
+    if(size > 0) std::memcpy(buffer_.data() + position, data, size);
+  }
+
+  template<typename U>
+  void writeTrivial(const U& value) {
+    writeBytes(&value, sizeof(U));
+  }
+
+  template<typename U>
+  void writeValue(const U& value) {
+    if constexpr(RH_IsReflected<U>::value) {
+      writeFields<U, 0>(value);
+    }
+    else if constexpr(std::is_same<U, std::string>::value) {
+      writeTrivial(static_cast<uint64_t>(value.size()));
+      writeBytes(value.data(), value.size());
+    }
+    else if constexpr(RH_IsVector<U>::value) {
+      using Element = typename U::value_type;
+      writeTrivial(static_cast<uint64_t>(value.size()));
+      if constexpr(RH_IsPadFree<Element>::value &&
+                   !RH_IsReflected<Element>::value) {
+        writeBytes(value.data(), value.size() * sizeof(Element));
+      }
+      else {
+        for(const Element& element : value) writeValue(element);
+      }
+    }
+    else if constexpr(RH_IsStdArray<U>::value && !RH_IsPadFree<U>::value) {
+      for(const auto& element : value) writeValue(element);
+    }
+    else {
+      static_assert(RH_IsPadFree<U>::value,
+                    "RH_BinaryWriter: U has padding, it must use RH_FIELDS");
+      writeTrivial(value);
+    }
+  }
+
+  template<typename T, size_t I>
+  void writeFields(const T& object) {
+    constexpr auto fields = RH_Fields<T>::descriptors();
+    if constexpr(I < RH_Fields<T>::count()) {
+      constexpr size_t end = RH_Fields<T>::trivialRunEnds()[I];
+      if constexpr(end > I + 1) {
+        using Last = typename std::tuple_element<
+          end - 1, decltype(fields)>::type::Type;
+        constexpr size_t begin = std::get<I>(fields).offset;
+        constexpr size_t size =
+          std::get<end - 1>(fields).offset + sizeof(Last) - begin;
+        writeBytes(reinterpret_cast<const unsigned char*>(&object) + begin,
+                   size);
+      }
+      else writeValue(std::get<I>(fields).get(object));
+      writeFields<T, end>(object);
+    }
+  }
+
+  Buffer& buffer_;
+};
+
+class RH_BinaryReader {
+ public:
+  RH_BinaryReader(const unsigned char* data, size_t size)
+      : data_(data), size_(size)
+  {}
+
+  explicit RH_BinaryReader(const RH_BinaryWriter::Buffer& buffer)
+      : RH_BinaryReader(buffer.data(), buffer.size())
+  {}
+
+  // Throws std::runtime_error if the record was written for another
+  // schema, the data ends before the record does or holds a bool other
+  // than 0 or 1. Vector sizes are bounded by the bytes left, at least
+  // one per element.
+  template<typename T>
+  void read(T& object) {
+    static_assert(RH_IsReflected<T>::value,
+                  "RH_BinaryReader: T must use RH_FIELDS");
+    constexpr uint64_t schemaHash = RH_Fields<T>::schemaHash();
+    uint64_t recordSchemaHash = 0;
+    readTrivial(recordSchemaHash);
+    if(recordSchemaHash != schemaHash) {
+      throw std::runtime_error("RH_BinaryReader: schema hash mismatch");
+    }
+    readValue(object);
+  }
+
+  size_t position() const {
+    return position_;
+  }
+
+  bool atEnd() const {
+    return position_ == size_;
+  }
+
+ private:
+  void readBytes(void* data, size_t size) {
+    if(size > size_ - position_) {
+      throw std::runtime_error("RH_BinaryReader: unexpected end of data");
+    }
+    if(size > 0) std::memcpy(data, data_ + position_, size);
+    position_ += size;
+  }
+
+  template<typename U>
+  void readTrivial(U& value) {
+    readBytes(&value, sizeof(U));
+  }
+
+  // Whether bools copied into a U from the data need checking.
+  template<typename U>
+  static constexpr bool hasBool() {
+    if constexpr(std::is_same<U, bool>::value) return true;
+    else if constexpr(RH_IsReflected<U>::value) {
+      bool result = false;
+      RH_Fields<U>::forEach([&result](const auto& field) {
+        using Type = typename std::decay_t<decltype(field)>::Type;
+        result = result || hasBool<Type>();
+      });
+      return result;
+    }
+    else if constexpr(RH_IsStdArray<U>::value) {
+      return hasBool<typename U::value_type>();
+    }
+    else return false;
+  }
+
+  // Bools of value read by bytes, as any byte but 0 and 1 makes them
+  // undefined.
+  template<typename U>
+  static void checkBools(const U& value) {
+    if constexpr(std::is_same<U, bool>::value) {
+      unsigned char byte = 0;
+      std::memcpy(&byte, &value, 1);
+      if(byte > 1) throw std::runtime_error("RH_BinaryReader: invalid bool");
+    }
+    else if constexpr(RH_IsReflected<U>::value && hasBool<U>()) {
+      RH_Fields<U>::forEach([&value](const auto& field) {
+        checkBools(field.get(value));
+      });
+    }
+    else if constexpr(RH_IsStdArray<U>::value && hasBool<U>()) {
+      for(const auto& element : value) checkBools(element);
+    }
+  }
+
+  template<typename T, size_t I, size_t End>
+  static void checkFieldsBools(const T& object) {
+    if constexpr(I < End) {
+      checkBools(std::get<I>(RH_Fields<T>::descriptors()).get(object));
+      checkFieldsBools<T, I + 1, End>(object);
+    }
+  }
+
+  size_t readSize(size_t elementSize) {
+    uint64_t size = 0;
+    readTrivial(size);
+    if(elementSize > 0 && size > (size_ - position_) / elementSize) {
+      throw std::runtime_error("RH_BinaryReader: unexpected end of data");
+    }
+    return static_cast<size_t>(size);
+  }
+
+  template<typename U>
+  void readValue(U& value) {
+    if constexpr(RH_IsReflected<U>::value) {
+      readFields<U, 0>(value);
+    }
+    else if constexpr(std::is_same<U, std::string>::value) {
+      value.resize(readSize(1));
+      readBytes(&value[0], value.size());
+    }
+    else if constexpr(RH_IsVector<U>::value) {
+      using Element = typename U::value_type;
+      if constexpr(RH_IsPadFree<Element>::value &&
+                   !RH_IsReflected<Element>::value) {
+        value.resize(readSize(sizeof(Element)));
+        readBytes(value.data(), value.size() * sizeof(Element));
+        if constexpr(hasBool<Element>()) {
+          for(const Element& element : value) checkBools(element);
+        }
+      }
+      else {
+        value.resize(readSize(1));
+        for(Element& element : value) readValue(element);
+      }
+    }
+    else if constexpr(RH_IsStdArray<U>::value && !RH_IsPadFree<U>::value) {
+      for(auto& element : value) readValue(element);
+    }
+    else {
+      static_assert(RH_IsPadFree<U>::value,
+                    "RH_BinaryReader: U has padding, it must use RH_FIELDS");
+      readTrivial(value);
+      checkBools(value);
+    }
+  }
+
+  template<typename T, size_t I>
+  void readFields(T& object) {
+    constexpr auto fields = RH_Fields<T>::descriptors();
+    if constexpr(I < RH_Fields<T>::count()) {
+      constexpr size_t end = RH_Fields<T>::trivialRunEnds()[I];
+      if constexpr(end > I + 1) {
+        using Last = typename std::tuple_element<
+          end - 1, decltype(fields)>::type::Type;
+        constexpr size_t begin = std::get<I>(fields).offset;
+        constexpr size_t size =
+          std::get<end - 1>(fields).offset + sizeof(Last) - begin;
+        readBytes(reinterpret_cast<unsigned char*>(&object) + begin, size);
+        checkFieldsBools<T, I, end>(object);
+      }
+      else readValue(std::get<I>(fields).get(object));
+      readFields<T, end>(object);
+    }
+  }
+
+  const unsigned char* data_;
+  size_t size_;
+  size_t position_{0};
+};
+
+#endif //__RH_FIELDS_BINARY_hpp__
@@ -0,0 +1,693 @@
+// Hey Emacs, this is -*- coding: utf-8 mode: c++ -*-
+#ifndef __RH_FIELDS_TEXT_hpp__
+#define __RH_FIELDS_TEXT_hpp__
+
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "RH_FIELDS.hpp"
+
+// JSON and CSV text of RH_FIELDS reflected classes.
+//
+// RH_TextWriter formats into a caller supplied buffer with std::to_chars
+// and never allocates. A record either fits as a whole or the buffer is
+// left as it was and false is returned, so callers flush and retry.
+//
+// RH_JsonParser and RH_CsvParser find fields by the FNV-1a hashes of
+// their names, computed at compile time. Malformed text throws
+// std::runtime_error; fields missing from the text keep their values.
+//
+// JSON handles nested reflected classes, std::array and std::vector.
+// CSV is for flat records: arithmetic, enum and string fields only.
+//
+// std::string_view and const char* fields own no text to parse into, so
+// they are write only: the parsers reject classes having them at compile
+// time. Such classes are output records, e.g. RH_TraceChromeEvent.
+
+template<typename T>
+class RH_FieldsByName {
+ public:
+  static constexpr uint64_t nameHash(std::string_view name) noexcept {
+    return RH_Fields<T>::hashString(14695981039346656037ull, name);
+  }
+
+  // Index of the field called name, or -1.
+  static int find(std::string_view name) noexcept {
+    const uint64_t hash = nameHash(name);
+    for(size_t i = 0; i < hashes.size(); ++i) {
+      if(hashes[i] == hash && names[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+  }
+
+  // Calls f with field index of object, index must be valid.
+  template<typename U, typename F>
+  static void visit(U& object, size_t index, F&& f) {
+    visit(object, index, f,
+          std::make_index_sequence<RH_Fields<T>::count()>());
+  }
+
+ private:
+  template<typename U, typename F, size_t... I>
+  static void visit(U& object, size_t index, F& f,
+                    std::index_sequence<I...>) {
+    constexpr auto fields = RH_Fields<T>::descriptors();
+    (void)((index == I ? (f(std::get<I>(fields).get(object)), true) : false)
+           || ...);
+  }
+
+  static constexpr auto buildNames() noexcept {
+    std::array<std::string_view, RH_Fields<T>::count()> names{};
+    size_t i = 0;
+    RH_Fields<T>::forEach([&](const auto& field) { names[i++] = field.name; });
+    return names;
+  }
+
+  static constexpr auto buildHashes() noexcept {
+    std::array<uint64_t, RH_Fields<T>::count()> hashes{};
+    size_t i = 0;
+    RH_Fields<T>::forEach([&](const auto& field) {
+      hashes[i++] = nameHash(field.name);
+    });
+    return hashes;
+  }
+
+  static constexpr auto names = buildNames();
+  static constexpr auto hashes = buildHashes();
+};
+
+template<typename T>
+struct RH_IsTextString
+    : std::integral_constant<bool,
+                             std::is_same<T, std::string>::value ||
+                             std::is_same<T, std::string_view>::value ||
+                             std::is_same<T, const char*>::value> {};
+
+template<typename T>
+struct RH_IsCsvField
+    : std::integral_constant<bool,
+                             std::is_arithmetic<T>::value ||
+                             std::is_enum<T>::value ||
+                             RH_IsTextString<T>::value> {};
+
+class RH_TextWriter {
+ public:
+  RH_TextWriter(char* data, size_t capacity)
+      : data_(data), capacity_(capacity)
+  {}
+
+  template<size_t N>
+  explicit RH_TextWriter(char (&data)[N])
+      : RH_TextWriter(data, N)
+  {}
+
+  const char* data() const {
+    return data_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  std::string_view view() const {
+    return std::string_view(data_, size_);
+  }
+
+  void clear() {
+    size_ = 0;
+  }
+
+  bool write(std::string_view text) {
+    return record([&] { put(text); });
+  }
+
+  // {"name":value,...}
+  template<typename T>
+  bool writeJson(const T& object) {
+    static_assert(RH_IsReflected<T>::value,
+                  "RH_TextWriter: T must use RH_FIELDS");
+    return record([&] { putJson(object); });
+  }
+
+  // name,name,...\n
+  template<typename T>
+  bool writeCsvHeader() {
+    return record([&] {
+      bool first = true;
+      RH_Fields<T>::forEach([&](const auto& field) {
+        if(!first) put(',');
+        first = false;
+        put(field.name);
+      });
+      put('\n');
+    });
+  }
+
+  // value,value,...\n
+  template<typename T>
+  bool writeCsvRow(const T& object) {
+    return record([&] {
+      bool first = true;
+      RH_Fields<T>::forEach([&](const auto& field) {
+        using Type = typename std::decay_t<decltype(field)>::Type;
+        static_assert(RH_IsCsvField<Type>::value,
+                      "RH_TextWriter: CSV rows need flat records");
+        if(!first) put(',');
+        first = false;
+        putCsv(field.get(object));
+      });
+      put('\n');
+    });
+  }
+
+ private:
+  template<typename F>
+  bool record(F&& f) {
+    const size_t begin = size_;
+    ok_ = true;
+    f();
+    if(!ok_) size_ = begin;
+    return ok_;
+  }
+
+  void put(char c) {
+    if(size_ < capacity_) data_[size_++] = c;
+    else ok_ = false;
+  }
+
+  void put(std::string_view text) {
+    if(text.size() <= capacity_ - size_) {
+      text.copy(data_ + size_, text.size());
+      size_ += text.size();
+    }
+    else ok_ = false;
+  }
+
+  template<typename U>
+  void putNumber(U value) {
+    if constexpr(std::is_same<U, bool>::value) {
+      put(value ? std::string_view("true") : std::string_view("false"));
+    }
+    else if constexpr(std::is_enum<U>::value) {
+      putNumber(static_cast<std::underlying_type_t<U>>(value));
+    }
+    else if constexpr(std::is_same<U, char>::value ||
+                      std::is_same<U, signed char>::value) {
+      putNumber(static_cast<int>(value));
+    }
+    else if constexpr(std::is_same<U, unsigned char>::value) {
+      putNumber(static_cast<unsigned>(value));
+    }
+    else {
+      auto result = std::to_chars(data_ + size_, data_ + capacity_, value);
+      if(result.ec == std::errc()) size_ = result.ptr - data_;
+      else ok_ = false;
+    }
+  }
+
+  void putJsonString(std::string_view text) {
+    static constexpr char hex[] = "0123456789abcdef";
+    put('"');
+    size_t run = 0;
+    for(size_t i = 0; i < text.size(); ++i) {
+      const unsigned char c = static_cast<unsigned char>(text[i]);
+      if(c >= 0x20 && c != '"' && c != '\\') continue;
+      put(text.substr(run, i - run));
+      run = i + 1;
+      switch(c) {
+        case '"': put("\\\""); break;
+        case '\\': put("\\\\"); break;
+        case '\n': put("\\n"); break;
+        case '\r': put("\\r"); break;
+        case '\t': put("\\t"); break;
+        default: {
+          const char escape[] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 15]};
+          put(std::string_view(escape, sizeof(escape)));
+        }
+      }
+    }
+    put(text.substr(run));
+    put('"');
+  }
+
+  template<typename U>
+  void putJson(const U& value) {
+    if constexpr(RH_IsReflected<U>::value) {
+      put('{');
+      bool first = true;
+      RH_Fields<U>::forEach([&](const auto& field) {
+        if(!first) put(',');
+        first = false;
+        put('"');
+        put(field.name);
+        put("\":");
+        putJson(field.get(value));
+      });
+      put('}');
+    }
+    else if constexpr(std::is_same<U, const char*>::value) {
+      if(value) putJsonString(value);
+      else put("null");
+    }
+    else if constexpr(RH_IsTextString<U>::value) {
+      putJsonString(value);
+    }
+    else if constexpr(RH_IsVector<U>::value || RH_IsStdArray<U>::value) {
+      put('[');
+      bool first = true;
+      for(const auto& element : value) {
+        if(!first) put(',');
+        first = false;
+        putJson(element);
+      }
+      put(']');
+    }
+    else if constexpr(std::is_floating_point<U>::value) {
+      // JSON has no NaN or infinity
+      if(std::isfinite(value)) putNumber(value);
+      else put("null");
+    }
+    else {
+      static_assert(std::is_arithmetic<U>::value || std::is_enum<U>::value,
+                    "RH_TextWriter: unsupported field type");
+      putNumber(value);
+    }
+  }
+
+  void putCsvString(std::string_view text) {
+    if(text.find_first_of(",\"\r\n") == std::string_view::npos) {
+      put(text);
+      return;
+    }
+    put('"');
+    size_t run = 0;
+    for(size_t quote = text.find('"'); quote != std::string_view::npos;
+        quote = text.find('"', quote + 1)) {
+      put(text.substr(run, quote + 1 - run));
+      run = quote;
+    }
+    put(text.substr(run));
+    put('"');
+  }
+
+  template<typename U>
+  void putCsv(const U& value) {
+    if constexpr(std::is_same<U, const char*>::value) {
+      if(value) putCsvString(value);
+    }
+    else if constexpr(RH_IsTextString<U>::value) {
+      putCsvString(value);
+    }
+    else putNumber(value);
+  }
+
+  char* data_;
+  size_t capacity_;
+  size_t size_{0};
+  bool ok_{true};
+};
+
+class RH_TextParser {
+ public:
+  size_t position() const {
+    return position_;
+  }
+
+  bool atEnd() const {
+    return position_ == text_.size();
+  }
+
+ protected:
+  explicit RH_TextParser(std::string_view text)
+      : text_(text)
+  {}
+
+  [[noreturn]] void fail(const char* what) const {
+    throw std::runtime_error(std::string(what) + " at offset " +
+                             std::to_string(position_));
+  }
+
+  bool consume(char c) {
+    if(position_ < text_.size() && text_[position_] == c) {
+      ++position_;
+      return true;
+    }
+    return false;
+  }
+
+  bool consume(std::string_view word) {
+    if(text_.substr(position_, word.size()) == word) {
+      position_ += word.size();
+      return true;
+    }
+    return false;
+  }
+
+  // Parses a number, bool or enum from token, which must be used up.
+  template<typename U>
+  void parseNumber(std::string_view token, U& value) {
+    const char* first = token.data();
+    const char* last = token.data() + token.size();
+    std::from_chars_result result{};
+    if constexpr(std::is_same<U, bool>::value) {
+      if(token == "true") value = true;
+      else if(token == "false") value = false;
+      else fail("expected true or false");
+      return;
+    }
+    else if constexpr(std::is_enum<U>::value) {
+      std::underlying_type_t<U> integer{};
+      parseNumber(token, integer);
+      value = static_cast<U>(integer);
+      return;
+    }
+    else if constexpr(std::is_same<U, char>::value ||
+                      std::is_same<U, signed char>::value ||
+                      std::is_same<U, unsigned char>::value) {
+      std::conditional_t<std::is_signed<U>::value, int, unsigned> integer{};
+      parseNumber(token, integer);
+      if(integer < std::numeric_limits<U>::min() ||
+         integer > std::numeric_limits<U>::max()) {
+        fail("number out of range");
+      }
+      value = static_cast<U>(integer);
+      return;
+    }
+    else if constexpr(std::is_floating_point<U>::value) {
+      if(token == "null") {
+        value = std::numeric_limits<U>::quiet_NaN();
+        return;
+      }
+      result = std::from_chars(first, last, value);
+    }
+    else result = std::from_chars(first, last, value);
+    if(result.ec != std::errc() || result.ptr != last) {
+      fail("malformed number");
+    }
+  }
+
+  std::string_view text_;
+  size_t position_{0};
+};
+
+class RH_JsonParser : public RH_TextParser {
+ public:
+  explicit RH_JsonParser(std::string_view text)
+      : RH_TextParser(text)
+  {}
+
+  // Reads the next JSON object into object, skipping unknown keys.
+  template<typename T>
+  void read(T& object) {
+    static_assert(RH_IsReflected<T>::value,
+                  "RH_JsonParser: T must use RH_FIELDS");
+    skipSpace();
+    readValue(object);
+    skipSpace();
+  }
+
+ private:
+  void skipSpace() {
+    while(position_ < text_.size() &&
+          (text_[position_] == ' ' || text_[position_] == '\n' ||
+           text_[position_] == '\r' || text_[position_] == '\t')) {
+      ++position_;
+    }
+  }
+
+  void expect(char c) {
+    skipSpace();
+    if(!consume(c)) fail("unexpected character");
+  }
+
+  std::string_view token() {
+    skipSpace();
+    const size_t begin = position_;
+    while(position_ < text_.size()) {
+      const char c = text_[position_];
+      if(c == ',' || c == '}' || c == ']' || c == ' ' || c == '\n' ||
+         c == '\r' || c == '\t') {
+        break;
+      }
+      ++position_;
+    }
+    if(position_ == begin) fail("expected a value");
+    return text_.substr(begin, position_ - begin);
+  }
+
+  // Keys are compared as written, escapes included.
+  std::string_view key() {
+    expect('"');
+    const size_t begin = position_;
+    while(position_ < text_.size() && text_[position_] != '"') {
+      if(text_[position_] == '\\') ++position_;
+      ++position_;
+    }
+    if(position_ >= text_.size()) fail("unterminated key");
+    std::string_view key = text_.substr(begin, position_ - begin);
+    ++position_;
+    expect(':');
+    return key;
+  }
+
+  unsigned hex4() {
+    unsigned code = 0;
+    auto result = std::from_chars(text_.data() + position_,
+                                  text_.data() + std::min(position_ + 4,
+                                                          text_.size()),
+                                  code, 16);
+    if(result.ec != std::errc() ||
+       result.ptr != text_.data() + position_ + 4) {
+      fail("malformed \\u escape");
+    }
+    position_ += 4;
+    return code;
+  }
+
+  void appendUtf8(std::string& value, unsigned code) {
+    if(code < 0x80) {
+      value += static_cast<char>(code);
+    }
+    else if(code < 0x800) {
+      value += static_cast<char>(0xc0 | (code >> 6));
+      value += static_cast<char>(0x80 | (code & 0x3f));
+    }
+    else if(code < 0x10000) {
+      value += static_cast<char>(0xe0 | (code >> 12));
+      value += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+      value += static_cast<char>(0x80 | (code & 0x3f));
+    }
+    else {
+      value += static_cast<char>(0xf0 | (code >> 18));
+      value += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+      value += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+      value += static_cast<char>(0x80 | (code & 0x3f));
+    }
+  }
+
+  void readString(std::string& value) {
+    expect('"');
+    value.clear();
+    for(;;) {
+      const size_t run = position_;
+      while(position_ < text_.size() && text_[position_] != '"' &&
+            text_[position_] != '\\') {
+        ++position_;
+      }
+      value.append(text_.data() + run, position_ - run);
+      if(position_ >= text_.size()) fail("unterminated string");
+      if(text_[position_++] == '"') return;
+      if(position_ >= text_.size()) fail("unterminated string");
+      switch(text_[position_++]) {
+        case '"': value += '"'; break;
+        case '\\': value += '\\'; break;
+        case '/': value += '/'; break;
+        case 'b': value += '\b'; break;
+        case 'f': value += '\f'; break;
+        case 'n': value += '\n'; break;
+        case 'r': value += '\r'; break;
+        case 't': value += '\t'; break;
+        case 'u': {
+          unsigned code = hex4();
+          if(code >= 0xd800 && code < 0xdc00 && consume("\\u")) {
+            unsigned low = hex4();
+            if(low < 0xdc00 || low >= 0xe000) fail("malformed surrogate pair");
+            code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+          }
+          appendUtf8(value, code);
+          break;
+        }
+        default: fail("malformed escape");
+      }
+    }
+  }
+
+  template<typename F>
+  void readList(char open, char close, F&& element) {
+    expect(open);
+    skipSpace();
+    if(consume(close)) return;
+    do {
+      element();
+      skipSpace();
+    } while(consume(','));
+    if(!consume(close)) fail("unexpected character");
+  }
+
+  void skipValue() {
+    skipSpace();
+    if(position_ >= text_.size()) fail("expected a value");
+    switch(text_[position_]) {
+      case '{':
+        readList('{', '}', [this] {
+          key();
+          skipValue();
+        });
+        break;
+      case '[':
+        readList('[', ']', [this] { skipValue(); });
+        break;
+      case '"':
+        ++position_;
+        while(position_ < text_.size() && text_[position_] != '"') {
+          if(text_[position_] == '\\') ++position_;
+          ++position_;
+        }
+        if(!consume('"')) fail("unterminated string");
+        break;
+      default:
+        token();
+    }
+  }
+
+  template<typename U>
+  void readValue(U& value) {
+    if constexpr(RH_IsReflected<U>::value) {
+      readList('{', '}', [&] {
+        const std::string_view name = key();
+        const int index = RH_FieldsByName<U>::find(name);
+        if(index < 0) skipValue();
+        else {
+          RH_FieldsByName<U>::visit(value, index,
+                                    [this](auto& field) { readValue(field); });
+        }
+      });
+    }
+    else if constexpr(std::is_same<U, std::string>::value) {
+      readString(value);
+    }
+    else if constexpr(RH_IsVector<U>::value) {
+      value.clear();
+      readList('[', ']', [&] {
+        value.emplace_back();
+        readValue(value.back());
+      });
+    }
+    else if constexpr(RH_IsStdArray<U>::value) {
+      size_t i = 0;
+      readList('[', ']', [&] {
+        if(i == value.size()) fail("too many array elements");
+        readValue(value[i++]);
+      });
+      if(i != value.size()) fail("too few array elements");
+    }
+    else {
+      static_assert(!RH_IsTextString<U>::value,
+                    "RH_JsonParser: string_view and const char* fields are "
+                    "write only");
+      static_assert(std::is_arithmetic<U>::value || std::is_enum<U>::value,
+                    "RH_JsonParser: unsupported field type");
+      parseNumber(token(), value);
+    }
+  }
+};
+
+// Maps the columns of a CSV header to the fields of T, then reads rows.
+template<typename T>
+class RH_CsvParser : public RH_TextParser {
+ public:
+  // Reads the header; columns that name no field of T are skipped.
+  explicit RH_CsvParser(std::string_view text)
+      : RH_TextParser(text) {
+    static_assert(RH_IsReflected<T>::value,
+                  "RH_CsvParser: T must use RH_FIELDS");
+    columnsCount_ = 0;
+    do {
+      if(columnsCount_ == maxColumns) fail("too many columns");
+      columns_[columnsCount_++] =
+        RH_FieldsByName<T>::find(cell());
+    } while(consume(','));
+    endOfLine();
+  }
+
+  // Returns false once the text is used up.
+  bool read(T& object) {
+    if(atEnd()) return false;
+    for(size_t column = 0; column < columnsCount_; ++column) {
+      if(column > 0 && !consume(',')) fail("too few cells");
+      const int index = columns_[column];
+      if(index < 0) {
+        cell();
+        continue;
+      }
+      RH_FieldsByName<T>::visit(object, index, [this](auto& field) {
+        using Type = std::decay_t<decltype(field)>;
+        static_assert(std::is_same<Type, std::string>::value ||
+                      !RH_IsTextString<Type>::value,
+                      "RH_CsvParser: string_view and const char* fields are "
+                      "write only");
+        static_assert(std::is_arithmetic<Type>::value ||
+                      std::is_enum<Type>::value ||
+                      std::is_same<Type, std::string>::value,
+                      "RH_CsvParser: CSV rows need flat records");
+        const std::string_view text = cell();
+        if constexpr(std::is_same<Type, std::string>::value) field = text;
+        else if(!text.empty()) parseNumber(text, field);
+      });
+    }
+    endOfLine();
+    return true;
+  }
+
+ private:
+  static constexpr size_t maxColumns = 256;
+
+  void endOfLine() {
+    consume('\r');
+    if(!consume('\n') && !atEnd()) fail("too many cells");
+  }
+
+  // Quoted cells with escaped quotes are unescaped into scratch_.
+  std::string_view cell() {
+    if(!consume('"')) {
+      const size_t begin = position_;
+      while(position_ < text_.size() && text_[position_] != ',' &&
+            text_[position_] != '\r' && text_[position_] != '\n') {
+        ++position_;
+      }
+      return text_.substr(begin, position_ - begin);
+    }
+    const size_t begin = position_;
+    size_t quote = text_.find('"', position_);
+    if(quote == std::string_view::npos) fail("unterminated cell");
+    position_ = quote + 1;
+    if(!consume('"')) return text_.substr(begin, quote - begin);
+    scratch_.assign(text_.data() + begin, quote + 1 - begin);
+    for(;;) {
+      quote = text_.find('"', position_);
+      if(quote == std::string_view::npos) fail("unterminated cell");
+      scratch_.append(text_.data() + position_, quote - position_);
+      position_ = quote + 1;
+      if(!consume('"')) return scratch_;
+      scratch_ += '"';
+    }
+  }
+
+  std::array<int, maxColumns> columns_;
+  size_t columnsCount_;
+  std::string scratch_;
+};
+
+#endif //__RH_FIELDS_TEXT_hpp__
@@ -107,10 +107,210 @@
 #define RH__FEP1_98(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_97(a, p0, __VA_ARGS__))
 #define RH__FEP1_99(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_98(a, p0, __VA_ARGS__))
 #define RH__FEP1_100(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_99(a, p0, __VA_ARGS__))
+#define RH__FEP1_101(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_100(a, p0, __VA_ARGS__))
+#define RH__FEP1_102(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_101(a, p0, __VA_ARGS__))
+#define RH__FEP1_103(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_102(a, p0, __VA_ARGS__))
+#define RH__FEP1_104(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_103(a, p0, __VA_ARGS__))
+#define RH__FEP1_105(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_104(a, p0, __VA_ARGS__))
+#define RH__FEP1_106(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_105(a, p0, __VA_ARGS__))
+#define RH__FEP1_107(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_106(a, p0, __VA_ARGS__))
+#define RH__FEP1_108(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_107(a, p0, __VA_ARGS__))
+#define RH__FEP1_109(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_108(a, p0, __VA_ARGS__))
+#define RH__FEP1_110(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_109(a, p0, __VA_ARGS__))
+#define RH__FEP1_111(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_110(a, p0, __VA_ARGS__))
+#define RH__FEP1_112(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_111(a, p0, __VA_ARGS__))
+#define RH__FEP1_113(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_112(a, p0, __VA_ARGS__))
+#define RH__FEP1_114(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_113(a, p0, __VA_ARGS__))
+#define RH__FEP1_115(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_114(a, p0, __VA_ARGS__))
+#define RH__FEP1_116(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_115(a, p0, __VA_ARGS__))
+#define RH__FEP1_117(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_116(a, p0, __VA_ARGS__))
+#define RH__FEP1_118(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_117(a, p0, __VA_ARGS__))
+#define RH__FEP1_119(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_118(a, p0, __VA_ARGS__))
+#define RH__FEP1_120(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_119(a, p0, __VA_ARGS__))
+#define RH__FEP1_121(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_120(a, p0, __VA_ARGS__))
+#define RH__FEP1_122(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_121(a, p0, __VA_ARGS__))
+#define RH__FEP1_123(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_122(a, p0, __VA_ARGS__))
+#define RH__FEP1_124(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_123(a, p0, __VA_ARGS__))
+#define RH__FEP1_125(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_124(a, p0, __VA_ARGS__))
+#define RH__FEP1_126(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_125(a, p0, __VA_ARGS__))
+#define RH__FEP1_127(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_126(a, p0, __VA_ARGS__))
+#define RH__FEP1_128(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_127(a, p0, __VA_ARGS__))
+#define RH__FEP1_129(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_128(a, p0, __VA_ARGS__))
+#define RH__FEP1_130(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_129(a, p0, __VA_ARGS__))
+#define RH__FEP1_131(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_130(a, p0, __VA_ARGS__))
+#define RH__FEP1_132(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_131(a, p0, __VA_ARGS__))
+#define RH__FEP1_133(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_132(a, p0, __VA_ARGS__))
+#define RH__FEP1_134(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_133(a, p0, __VA_ARGS__))
+#define RH__FEP1_135(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_134(a, p0, __VA_ARGS__))
+#define RH__FEP1_136(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_135(a, p0, __VA_ARGS__))
+#define RH__FEP1_137(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_136(a, p0, __VA_ARGS__))
+#define RH__FEP1_138(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_137(a, p0, __VA_ARGS__))
+#define RH__FEP1_139(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_138(a, p0, __VA_ARGS__))
+#define RH__FEP1_140(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_139(a, p0, __VA_ARGS__))
+#define RH__FEP1_141(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_140(a, p0, __VA_ARGS__))
+#define RH__FEP1_142(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_141(a, p0, __VA_ARGS__))
+#define RH__FEP1_143(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_142(a, p0, __VA_ARGS__))
+#define RH__FEP1_144(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_143(a, p0, __VA_ARGS__))
+#define RH__FEP1_145(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_144(a, p0, __VA_ARGS__))
+#define RH__FEP1_146(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_145(a, p0, __VA_ARGS__))
+#define RH__FEP1_147(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_146(a, p0, __VA_ARGS__))
+#define RH__FEP1_148(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_147(a, p0, __VA_ARGS__))
+#define RH__FEP1_149(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_148(a, p0, __VA_ARGS__))
+#define RH__FEP1_150(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_149(a, p0, __VA_ARGS__))
+#define RH__FEP1_151(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_150(a, p0, __VA_ARGS__))
+#define RH__FEP1_152(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_151(a, p0, __VA_ARGS__))
+#define RH__FEP1_153(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_152(a, p0, __VA_ARGS__))
+#define RH__FEP1_154(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_153(a, p0, __VA_ARGS__))
+#define RH__FEP1_155(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_154(a, p0, __VA_ARGS__))
+#define RH__FEP1_156(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_155(a, p0, __VA_ARGS__))
+#define RH__FEP1_157(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_156(a, p0, __VA_ARGS__))
+#define RH__FEP1_158(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_157(a, p0, __VA_ARGS__))
+#define RH__FEP1_159(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_158(a, p0, __VA_ARGS__))
+#define RH__FEP1_160(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_159(a, p0, __VA_ARGS__))
+#define RH__FEP1_161(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_160(a, p0, __VA_ARGS__))
+#define RH__FEP1_162(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_161(a, p0, __VA_ARGS__))
+#define RH__FEP1_163(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_162(a, p0, __VA_ARGS__))
+#define RH__FEP1_164(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_163(a, p0, __VA_ARGS__))
+#define RH__FEP1_165(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_164(a, p0, __VA_ARGS__))
+#define RH__FEP1_166(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_165(a, p0, __VA_ARGS__))
+#define RH__FEP1_167(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_166(a, p0, __VA_ARGS__))
+#define RH__FEP1_168(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_167(a, p0, __VA_ARGS__))
+#define RH__FEP1_169(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_168(a, p0, __VA_ARGS__))
+#define RH__FEP1_170(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_169(a, p0, __VA_ARGS__))
+#define RH__FEP1_171(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_170(a, p0, __VA_ARGS__))
+#define RH__FEP1_172(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_171(a, p0, __VA_ARGS__))
+#define RH__FEP1_173(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_172(a, p0, __VA_ARGS__))
+#define RH__FEP1_174(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_173(a, p0, __VA_ARGS__))
+#define RH__FEP1_175(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_174(a, p0, __VA_ARGS__))
+#define RH__FEP1_176(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_175(a, p0, __VA_ARGS__))
+#define RH__FEP1_177(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_176(a, p0, __VA_ARGS__))
+#define RH__FEP1_178(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_177(a, p0, __VA_ARGS__))
+#define RH__FEP1_179(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_178(a, p0, __VA_ARGS__))
+#define RH__FEP1_180(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_179(a, p0, __VA_ARGS__))
+#define RH__FEP1_181(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_180(a, p0, __VA_ARGS__))
+#define RH__FEP1_182(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_181(a, p0, __VA_ARGS__))
+#define RH__FEP1_183(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_182(a, p0, __VA_ARGS__))
+#define RH__FEP1_184(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_183(a, p0, __VA_ARGS__))
+#define RH__FEP1_185(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_184(a, p0, __VA_ARGS__))
+#define RH__FEP1_186(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_185(a, p0, __VA_ARGS__))
+#define RH__FEP1_187(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_186(a, p0, __VA_ARGS__))
+#define RH__FEP1_188(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_187(a, p0, __VA_ARGS__))
+#define RH__FEP1_189(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_188(a, p0, __VA_ARGS__))
+#define RH__FEP1_190(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_189(a, p0, __VA_ARGS__))
+#define RH__FEP1_191(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_190(a, p0, __VA_ARGS__))
+#define RH__FEP1_192(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_191(a, p0, __VA_ARGS__))
+#define RH__FEP1_193(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_192(a, p0, __VA_ARGS__))
+#define RH__FEP1_194(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_193(a, p0, __VA_ARGS__))
+#define RH__FEP1_195(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_194(a, p0, __VA_ARGS__))
+#define RH__FEP1_196(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_195(a, p0, __VA_ARGS__))
+#define RH__FEP1_197(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_196(a, p0, __VA_ARGS__))
+#define RH__FEP1_198(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_197(a, p0, __VA_ARGS__))
+#define RH__FEP1_199(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_198(a, p0, __VA_ARGS__))
+#define RH__FEP1_200(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_199(a, p0, __VA_ARGS__))
+#define RH__FEP1_201(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_200(a, p0, __VA_ARGS__))
+#define RH__FEP1_202(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_201(a, p0, __VA_ARGS__))
+#define RH__FEP1_203(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_202(a, p0, __VA_ARGS__))
+#define RH__FEP1_204(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_203(a, p0, __VA_ARGS__))
+#define RH__FEP1_205(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_204(a, p0, __VA_ARGS__))
+#define RH__FEP1_206(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_205(a, p0, __VA_ARGS__))
+#define RH__FEP1_207(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_206(a, p0, __VA_ARGS__))
+#define RH__FEP1_208(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_207(a, p0, __VA_ARGS__))
+#define RH__FEP1_209(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_208(a, p0, __VA_ARGS__))
+#define RH__FEP1_210(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_209(a, p0, __VA_ARGS__))
+#define RH__FEP1_211(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_210(a, p0, __VA_ARGS__))
+#define RH__FEP1_212(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_211(a, p0, __VA_ARGS__))
+#define RH__FEP1_213(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_212(a, p0, __VA_ARGS__))
+#define RH__FEP1_214(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_213(a, p0, __VA_ARGS__))
+#define RH__FEP1_215(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_214(a, p0, __VA_ARGS__))
+#define RH__FEP1_216(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_215(a, p0, __VA_ARGS__))
+#define RH__FEP1_217(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_216(a, p0, __VA_ARGS__))
+#define RH__FEP1_218(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_217(a, p0, __VA_ARGS__))
+#define RH__FEP1_219(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_218(a, p0, __VA_ARGS__))
+#define RH__FEP1_220(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_219(a, p0, __VA_ARGS__))
+#define RH__FEP1_221(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_220(a, p0, __VA_ARGS__))
+#define RH__FEP1_222(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_221(a, p0, __VA_ARGS__))
+#define RH__FEP1_223(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_222(a, p0, __VA_ARGS__))
+#define RH__FEP1_224(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_223(a, p0, __VA_ARGS__))
+#define RH__FEP1_225(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_224(a, p0, __VA_ARGS__))
+#define RH__FEP1_226(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_225(a, p0, __VA_ARGS__))
+#define RH__FEP1_227(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_226(a, p0, __VA_ARGS__))
+#define RH__FEP1_228(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_227(a, p0, __VA_ARGS__))
+#define RH__FEP1_229(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_228(a, p0, __VA_ARGS__))
+#define RH__FEP1_230(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_229(a, p0, __VA_ARGS__))
+#define RH__FEP1_231(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_230(a, p0, __VA_ARGS__))
+#define RH__FEP1_232(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_231(a, p0, __VA_ARGS__))
+#define RH__FEP1_233(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_232(a, p0, __VA_ARGS__))
+#define RH__FEP1_234(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_233(a, p0, __VA_ARGS__))
+#define RH__FEP1_235(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_234(a, p0, __VA_ARGS__))
+#define RH__FEP1_236(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_235(a, p0, __VA_ARGS__))
+#define RH__FEP1_237(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_236(a, p0, __VA_ARGS__))
+#define RH__FEP1_238(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_237(a, p0, __VA_ARGS__))
+#define RH__FEP1_239(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_238(a, p0, __VA_ARGS__))
+#define RH__FEP1_240(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_239(a, p0, __VA_ARGS__))
+#define RH__FEP1_241(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_240(a, p0, __VA_ARGS__))
+#define RH__FEP1_242(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_241(a, p0, __VA_ARGS__))
+#define RH__FEP1_243(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_242(a, p0, __VA_ARGS__))
+#define RH__FEP1_244(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_243(a, p0, __VA_ARGS__))
+#define RH__FEP1_245(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_244(a, p0, __VA_ARGS__))
+#define RH__FEP1_246(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_245(a, p0, __VA_ARGS__))
+#define RH__FEP1_247(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_246(a, p0, __VA_ARGS__))
+#define RH__FEP1_248(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_247(a, p0, __VA_ARGS__))
+#define RH__FEP1_249(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_248(a, p0, __VA_ARGS__))
+#define RH__FEP1_250(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_249(a, p0, __VA_ARGS__))
+#define RH__FEP1_251(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_250(a, p0, __VA_ARGS__))
+#define RH__FEP1_252(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_251(a, p0, __VA_ARGS__))
+#define RH__FEP1_253(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_252(a, p0, __VA_ARGS__))
+#define RH__FEP1_254(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_253(a, p0, __VA_ARGS__))
+#define RH__FEP1_255(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_254(a, p0, __VA_ARGS__))
+#define RH__FEP1_256(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_255(a, p0, __VA_ARGS__))
+#define RH__FEP1_257(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_256(a, p0, __VA_ARGS__))
+#define RH__FEP1_258(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_257(a, p0, __VA_ARGS__))
+#define RH__FEP1_259(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_258(a, p0, __VA_ARGS__))
+#define RH__FEP1_260(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_259(a, p0, __VA_ARGS__))
+#define RH__FEP1_261(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_260(a, p0, __VA_ARGS__))
+#define RH__FEP1_262(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_261(a, p0, __VA_ARGS__))
+#define RH__FEP1_263(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_262(a, p0, __VA_ARGS__))
+#define RH__FEP1_264(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_263(a, p0, __VA_ARGS__))
+#define RH__FEP1_265(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_264(a, p0, __VA_ARGS__))
+#define RH__FEP1_266(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_265(a, p0, __VA_ARGS__))
+#define RH__FEP1_267(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_266(a, p0, __VA_ARGS__))
+#define RH__FEP1_268(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_267(a, p0, __VA_ARGS__))
+#define RH__FEP1_269(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_268(a, p0, __VA_ARGS__))
+#define RH__FEP1_270(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_269(a, p0, __VA_ARGS__))
+#define RH__FEP1_271(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_270(a, p0, __VA_ARGS__))
+#define RH__FEP1_272(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_271(a, p0, __VA_ARGS__))
+#define RH__FEP1_273(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_272(a, p0, __VA_ARGS__))
+#define RH__FEP1_274(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_273(a, p0, __VA_ARGS__))
+#define RH__FEP1_275(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_274(a, p0, __VA_ARGS__))
+#define RH__FEP1_276(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_275(a, p0, __VA_ARGS__))
+#define RH__FEP1_277(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_276(a, p0, __VA_ARGS__))
+#define RH__FEP1_278(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_277(a, p0, __VA_ARGS__))
+#define RH__FEP1_279(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_278(a, p0, __VA_ARGS__))
+#define RH__FEP1_280(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_279(a, p0, __VA_ARGS__))
+#define RH__FEP1_281(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_280(a, p0, __VA_ARGS__))
+#define RH__FEP1_282(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_281(a, p0, __VA_ARGS__))
+#define RH__FEP1_283(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_282(a, p0, __VA_ARGS__))
+#define RH__FEP1_284(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_283(a, p0, __VA_ARGS__))
+#define RH__FEP1_285(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_284(a, p0, __VA_ARGS__))
+#define RH__FEP1_286(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_285(a, p0, __VA_ARGS__))
+#define RH__FEP1_287(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_286(a, p0, __VA_ARGS__))
+#define RH__FEP1_288(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_287(a, p0, __VA_ARGS__))
+#define RH__FEP1_289(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_288(a, p0, __VA_ARGS__))
+#define RH__FEP1_290(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_289(a, p0, __VA_ARGS__))
+#define RH__FEP1_291(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_290(a, p0, __VA_ARGS__))
+#define RH__FEP1_292(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_291(a, p0, __VA_ARGS__))
+#define RH__FEP1_293(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_292(a, p0, __VA_ARGS__))
+#define RH__FEP1_294(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_293(a, p0, __VA_ARGS__))
+#define RH__FEP1_295(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_294(a, p0, __VA_ARGS__))
+#define RH__FEP1_296(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_295(a, p0, __VA_ARGS__))
+#define RH__FEP1_297(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_296(a, p0, __VA_ARGS__))
+#define RH__FEP1_298(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_297(a, p0, __VA_ARGS__))
+#define RH__FEP1_299(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_298(a, p0, __VA_ARGS__))
+#define RH__FEP1_300(a, p0, x, ...) RH__FEP1_EXPAND(a(p0, x) RH__FEP1_299(a, p0, __VA_ARGS__))
 
-#define RH__FEP1_GET_MACRO(_1,_2,_3,_4,_5,_6,_7,_8,_9,_10,_11,_12,_13,_14,_15,_16,_17,_18,_19,_20,_21,_22,_23,_24,_25,_26,_27,_28,_29,_30,_31,_32,_33,_34,_35,_36,_37,_38,_39,_40,_41,_42,_43,_44,_45,_46,_47,_48,_49,_50,_51,_52,_53,_54,_55,_56,_57,_58,_59,_60,_61,_62,_63,_64,_65,_66,_67,_68,_69,_70,_71,_72,_73,_74,_75,_76,_77,_78,_79,_80,_81,_82,_83,_84,_85,_86,_87,_88,_89,_90,_91,_92,_93,_94,_95,_96,_97,_98,_99,_100,name,...) name
+#define RH__FEP1_GET_MACRO(_1,_2,_3,_4,_5,_6,_7,_8,_9,_10,_11,_12,_13,_14,_15,_16,_17,_18,_19,_20,_21,_22,_23,_24,_25,_26,_27,_28,_29,_30,_31,_32,_33,_34,_35,_36,_37,_38,_39,_40,_41,_42,_43,_44,_45,_46,_47,_48,_49,_50,_51,_52,_53,_54,_55,_56,_57,_58,_59,_60,_61,_62,_63,_64,_65,_66,_67,_68,_69,_70,_71,_72,_73,_74,_75,_76,_77,_78,_79,_80,_81,_82,_83,_84,_85,_86,_87,_88,_89,_90,_91,_92,_93,_94,_95,_96,_97,_98,_99,_100,_101,_102,_103,_104,_105,_106,_107,_108,_109,_110,_111,_112,_113,_114,_115,_116,_117,_118,_119,_120,_121,_122,_123,_124,_125,_126,_127,_128,_129,_130,_131,_132,_133,_134,_135,_136,_137,_138,_139,_140,_141,_142,_143,_144,_145,_146,_147,_148,_149,_150,_151,_152,_153,_154,_155,_156,_157,_158,_159,_160,_161,_162,_163,_164,_165,_166,_167,_168,_169,_170,_171,_172,_173,_174,_175,_176,_177,_178,_179,_180,_181,_182,_183,_184,_185,_186,_187,_188,_189,_190,_191,_192,_193,_194,_195,_196,_197,_198,_199,_200,_201,_202,_203,_204,_205,_206,_207,_208,_209,_210,_211,_212,_213,_214,_215,_216,_217,_218,_219,_220,_221,_222,_223,_224,_225,_226,_227,_228,_229,_230,_231,_232,_233,_234,_235,_236,_237,_238,_239,_240,_241,_242,_243,_244,_245,_246,_247,_248,_249,_250,_251,_252,_253,_254,_255,_256,_257,_258,_259,_260,_261,_262,_263,_264,_265,_266,_267,_268,_269,_270,_271,_272,_273,_274,_275,_276,_277,_278,_279,_280,_281,_282,_283,_284,_285,_286,_287,_288,_289,_290,_291,_292,_293,_294,_295,_296,_297,_298,_299,_300,name,...) name
 
 #define RH_FOR_EACH_P1(a, p0, ...) \
-RH__FEP1_EXPAND(RH__FEP1_GET_MACRO(__VA_ARGS__,RH__FEP1_100,RH__FEP1_99,RH__FEP1_98,RH__FEP1_97,RH__FEP1_96,RH__FEP1_95,RH__FEP1_94,RH__FEP1_93,RH__FEP1_92,RH__FEP1_91,RH__FEP1_90,RH__FEP1_89,RH__FEP1_88,RH__FEP1_87,RH__FEP1_86,RH__FEP1_85,RH__FEP1_84,RH__FEP1_83,RH__FEP1_82,RH__FEP1_81,RH__FEP1_80,RH__FEP1_79,RH__FEP1_78,RH__FEP1_77,RH__FEP1_76,RH__FEP1_75,RH__FEP1_74,RH__FEP1_73,RH__FEP1_72,RH__FEP1_71,RH__FEP1_70,RH__FEP1_69,RH__FEP1_68,RH__FEP1_67,RH__FEP1_66,RH__FEP1_65,RH__FEP1_64,RH__FEP1_63,RH__FEP1_62,RH__FEP1_61,RH__FEP1_60,RH__FEP1_59,RH__FEP1_58,RH__FEP1_57,RH__FEP1_56,RH__FEP1_55,RH__FEP1_54,RH__FEP1_53,RH__FEP1_52,RH__FEP1_51,RH__FEP1_50,RH__FEP1_49,RH__FEP1_48,RH__FEP1_47,RH__FEP1_46,RH__FEP1_45,RH__FEP1_44,RH__FEP1_43,RH__FEP1_42,RH__FEP1_41,RH__FEP1_40,RH__FEP1_39,RH__FEP1_38,RH__FEP1_37,RH__FEP1_36,RH__FEP1_35,RH__FEP1_34,RH__FEP1_33,RH__FEP1_32,RH__FEP1_31,RH__FEP1_30,RH__FEP1_29,RH__FEP1_28,RH__FEP1_27,RH__FEP1_26,RH__FEP1_25,RH__FEP1_24,RH__FEP1_23,RH__FEP1_22,RH__FEP1_21,RH__FEP1_20,RH__FEP1_19,RH__FEP1_18,RH__FEP1_17,RH__FEP1_16,RH__FEP1_15,RH__FEP1_14,RH__FEP1_13,RH__FEP1_12,RH__FEP1_11,RH__FEP1_10,RH__FEP1_9,RH__FEP1_8,RH__FEP1_7,RH__FEP1_6,RH__FEP1_5,RH__FEP1_4,RH__FEP1_3,RH__FEP1_2,RH__FEP1_1,)(a, p0, __VA_ARGS__))
+RH__FEP1_EXPAND(RH__FEP1_GET_MACRO(__VA_ARGS__,RH__FEP1_300,RH__FEP1_299,RH__FEP1_298,RH__FEP1_297,RH__FEP1_296,RH__FEP1_295,RH__FEP1_294,RH__FEP1_293,RH__FEP1_292,RH__FEP1_291,RH__FEP1_290,RH__FEP1_289,RH__FEP1_288,RH__FEP1_287,RH__FEP1_286,RH__FEP1_285,RH__FEP1_284,RH__FEP1_283,RH__FEP1_282,RH__FEP1_281,RH__FEP1_280,RH__FEP1_279,RH__FEP1_278,RH__FEP1_277,RH__FEP1_276,RH__FEP1_275,RH__FEP1_274,RH__FEP1_273,RH__FEP1_272,RH__FEP1_271,RH__FEP1_270,RH__FEP1_269,RH__FEP1_268,RH__FEP1_267,RH__FEP1_266,RH__FEP1_265,RH__FEP1_264,RH__FEP1_263,RH__FEP1_262,RH__FEP1_261,RH__FEP1_260,RH__FEP1_259,RH__FEP1_258,RH__FEP1_257,RH__FEP1_256,RH__FEP1_255,RH__FEP1_254,RH__FEP1_253,RH__FEP1_252,RH__FEP1_251,RH__FEP1_250,RH__FEP1_249,RH__FEP1_248,RH__FEP1_247,RH__FEP1_246,RH__FEP1_245,RH__FEP1_244,RH__FEP1_243,RH__FEP1_242,RH__FEP1_241,RH__FEP1_240,RH__FEP1_239,RH__FEP1_238,RH__FEP1_237,RH__FEP1_236,RH__FEP1_235,RH__FEP1_234,RH__FEP1_233,RH__FEP1_232,RH__FEP1_231,RH__FEP1_230,RH__FEP1_229,RH__FEP1_228,RH__FEP1_227,RH__FEP1_226,RH__FEP1_225,RH__FEP1_224,RH__FEP1_223,RH__FEP1_222,RH__FEP1_221,RH__FEP1_220,RH__FEP1_219,RH__FEP1_218,RH__FEP1_217,RH__FEP1_216,RH__FEP1_215,RH__FEP1_214,RH__FEP1_213,RH__FEP1_212,RH__FEP1_211,RH__FEP1_210,RH__FEP1_209,RH__FEP1_208,RH__FEP1_207,RH__FEP1_206,RH__FEP1_205,RH__FEP1_204,RH__FEP1_203,RH__FEP1_202,RH__FEP1_201,RH__FEP1_200,RH__FEP1_199,RH__FEP1_198,RH__FEP1_197,RH__FEP1_196,RH__FEP1_195,RH__FEP1_194,RH__FEP1_193,RH__FEP1_192,RH__FEP1_191,RH__FEP1_190,RH__FEP1_189,RH__FEP1_188,RH__FEP1_187,RH__FEP1_186,RH__FEP1_185,RH__FEP1_184,RH__FEP1_183,RH__FEP1_182,RH__FEP1_181,RH__FEP1_180,RH__FEP1_179,RH__FEP1_178,RH__FEP1_177,RH__FEP1_176,RH__FEP1_175,RH__FEP1_174,RH__FEP1_173,RH__FEP1_172,RH__FEP1_171,RH__FEP1_170,RH__FEP1_169,RH__FEP1_168,RH__FEP1_167,RH__FEP1_166,RH__FEP1_165,RH__FEP1_164,RH__FEP1_163,RH__FEP1_162,RH__FEP1_161,RH__FEP1_160,RH__FEP1_159,RH__FEP1_158,RH__FEP1_157,RH__FEP1_156,RH__FEP1_155,RH__FEP1_154,RH__FEP1_153,RH__FEP1_152,RH__FEP1_151,RH__FEP1_150,RH__FEP1_149,RH__FEP1_148,RH__FEP1_147,RH__FEP1_146,RH__FEP1_145,RH__FEP1_144,RH__FEP1_143,RH__FEP1_142,RH__FEP1_141,RH__FEP1_140,RH__FEP1_139,RH__FEP1_138,RH__FEP1_137,RH__FEP1_136,RH__FEP1_135,RH__FEP1_134,RH__FEP1_133,RH__FEP1_132,RH__FEP1_131,RH__FEP1_130,RH__FEP1_129,RH__FEP1_128,RH__FEP1_127,RH__FEP1_126,RH__FEP1_125,RH__FEP1_124,RH__FEP1_123,RH__FEP1_122,RH__FEP1_121,RH__FEP1_120,RH__FEP1_119,RH__FEP1_118,RH__FEP1_117,RH__FEP1_116,RH__FEP1_115,RH__FEP1_114,RH__FEP1_113,RH__FEP1_112,RH__FEP1_111,RH__FEP1_110,RH__FEP1_109,RH__FEP1_108,RH__FEP1_107,RH__FEP1_106,RH__FEP1_105,RH__FEP1_104,RH__FEP1_103,RH__FEP1_102,RH__FEP1_101,RH__FEP1_100,RH__FEP1_99,RH__FEP1_98,RH__FEP1_97,RH__FEP1_96,RH__FEP1_95,RH__FEP1_94,RH__FEP1_93,RH__FEP1_92,RH__FEP1_91,RH__FEP1_90,RH__FEP1_89,RH__FEP1_88,RH__FEP1_87,RH__FEP1_86,RH__FEP1_85,RH__FEP1_84,RH__FEP1_83,RH__FEP1_82,RH__FEP1_81,RH__FEP1_80,RH__FEP1_79,RH__FEP1_78,RH__FEP1_77,RH__FEP1_76,RH__FEP1_75,RH__FEP1_74,RH__FEP1_73,RH__FEP1_72,RH__FEP1_71,RH__FEP1_70,RH__FEP1_69,RH__FEP1_68,RH__FEP1_67,RH__FEP1_66,RH__FEP1_65,RH__FEP1_64,RH__FEP1_63,RH__FEP1_62,RH__FEP1_61,RH__FEP1_60,RH__FEP1_59,RH__FEP1_58,RH__FEP1_57,RH__FEP1_56,RH__FEP1_55,RH__FEP1_54,RH__FEP1_53,RH__FEP1_52,RH__FEP1_51,RH__FEP1_50,RH__FEP1_49,RH__FEP1_48,RH__FEP1_47,RH__FEP1_46,RH__FEP1_45,RH__FEP1_44,RH__FEP1_43,RH__FEP1_42,RH__FEP1_41,RH__FEP1_40,RH__FEP1_39,RH__FEP1_38,RH__FEP1_37,RH__FEP1_36,RH__FEP1_35,RH__FEP1_34,RH__FEP1_33,RH__FEP1_32,RH__FEP1_31,RH__FEP1_30,RH__FEP1_29,RH__FEP1_28,RH__FEP1_27,RH__FEP1_26,RH__FEP1_25,RH__FEP1_24,RH__FEP1_23,RH__FEP1_22,RH__FEP1_21,RH__FEP1_20,RH__FEP1_19,RH__FEP1_18,RH__FEP1_17,RH__FEP1_16,RH__FEP1_15,RH__FEP1_14,RH__FEP1_13,RH__FEP1_12,RH__FEP1_11,RH__FEP1_10,RH__FEP1_9,RH__FEP1_8,RH__FEP1_7,RH__FEP1_6,RH__FEP1_5,RH__FEP1_4,RH__FEP1_3,RH__FEP1_2,RH__FEP1_1,)(a, p0, __VA_ARGS__))
 
 #endif //__RH_FOR_EACH_P1_h__
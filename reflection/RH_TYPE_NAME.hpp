@@ -0,0 +1,49 @@
+// Hey Emacs, this is -*- coding: utf-8 mode: c++ -*-
+#ifndef __RH_TYPE_NAME_hpp__
+#define __RH_TYPE_NAME_hpp__
+
+#include <string_view>
+
+// Compile-time names of types and members, cut out of the compiler's
+// __PRETTY_FUNCTION__ (gcc and clang):
+//
+//   RH_TypeName<std::vector<int>>()  -> "std::vector<int>"
+//   RH_MemberName<&Probe::m_count>() -> "m_count"
+//
+// Spelling follows the compiler, so compare names from one compiler only.
+
+#if !defined(__GNUC__)
+#error "RH_TYPE_NAME.hpp needs __PRETTY_FUNCTION__ (gcc or clang)"
+#endif
+
+// Template argument following marker in a pretty function name: gcc
+// writes "[with T = int; ...]", clang "[T = int]".
+constexpr std::string_view
+RH__PrettyFunctionArgument(std::string_view pretty,
+                           std::string_view marker) noexcept {
+  const size_t begin = pretty.find(marker) + marker.size();
+  size_t end = begin;
+  int depth = 0;
+  for(; end < pretty.size(); ++end) {
+    const char c = pretty[end];
+    if(c == '<' || c == '(' || c == '[') ++depth;
+    else if(c == '>' || c == ')') --depth;
+    else if(c == ']' && depth-- == 0) break;
+    else if(c == ';' && depth == 0) break;
+  }
+  return pretty.substr(begin, end - begin);
+}
+
+template<typename T>
+constexpr std::string_view RH_TypeName() noexcept {
+  return RH__PrettyFunctionArgument(__PRETTY_FUNCTION__, "T = ");
+}
+
+template<auto Member>
+constexpr std::string_view RH_MemberName() noexcept {
+  constexpr std::string_view qualified =
+    RH__PrettyFunctionArgument(__PRETTY_FUNCTION__, "Member = ");
+  return qualified.substr(qualified.rfind("::") + 2);
+}
+
+#endif //__RH_TYPE_NAME_hpp__
@@ -1,5 +1,5 @@
 // Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
-// compile: g++ -std=c++14 -Wall -g -ggdb RH_ENUM_CLASS_ITEM_UTYPE_SHELL_demo.cxx -o RH_ENUM_CLASS_ITEM_UTYPE_SHELL_demo -I../../server
+// compile: g++ -std=c++17 -Wall -g -ggdb RH_ENUM_CLASS_ITEM_UTYPE_SHELL_demo.cxx -o RH_ENUM_CLASS_ITEM_UTYPE_SHELL_demo -I../../server
 
 #include <iostream>
 
@@ -76,5 +76,5 @@ int main(int argc, char **argv) {
 
 // Emacs, here are file hints.
 // Local Variables:
-// compile-command: "g++ -std=c++14 -Wall -g -ggdb RH_ENUM_CLASS_ITEM_UTYPE_SHELL_demo.cxx -o RH_ENUM_CLASS_ITEM_UTYPE_SHELL_demo -I../../server"
+// compile-command: "g++ -std=c++17 -Wall -g -ggdb RH_ENUM_CLASS_ITEM_UTYPE_SHELL_demo.cxx -o RH_ENUM_CLASS_ITEM_UTYPE_SHELL_demo -I../../server"
 // End:
@@ -1,5 +1,5 @@
 // Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
-// compile: g++ -std=c++14 -Wall -g -ggdb RH_ENUM_RSHELL_demo.cxx -o RH_ENUM_RSHELL_demo -I../../server
+// compile: g++ -std=c++17 -Wall -g -ggdb RH_ENUM_RSHELL_demo.cxx -o RH_ENUM_RSHELL_demo -I../../server
 
 #include "../RH_ENUM_SHELL.hpp"
 
@@ -72,5 +72,5 @@ int main(int argc, char **argv) {
 
 // Emacs, here are this file hints.
 // Local Variables:
-// compile-command: "g++ -std=c++14 -Wall -g -ggdb RH_ENUM_RSHELL_demo.cxx -o RH_ENUM_RSHELL_demo -I../../server"
+// compile-command: "g++ -std=c++17 -Wall -g -ggdb RH_ENUM_RSHELL_demo.cxx -o RH_ENUM_RSHELL_demo -I../../server"
 // End:
@@ -0,0 +1,45 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+// compile: g++ -std=c++17 -Wall -g -ggdb RH_ENUM_SET_MAP_demo.cxx -o RH_ENUM_SET_MAP_demo
+
+#include <iostream>
+
+#include "../RH_ENUM_SHELL.hpp"
+
+RH_ENUM_CLASS_SHELL(Fault,
+                    overTemperature, underVoltage, overVoltage,
+                    sensorLost, brownOut = underVoltage);
+
+int main(int argc, char **argv) {
+  // Fault flags as a bit set
+  Fault::EnumSet active{Fault::Item::overVoltage, Fault::Item::sensorLost};
+  Fault::EnumSet latched{Fault::Item::brownOut};
+  latched |= active;
+
+  std::cout << "latched faults (" << latched.size() << "):";
+  for(Fault::Item fault : latched) {
+    std::cout << " " << Fault::itemName(fault);
+  }
+  std::cout << std::endl;
+
+  std::cout << "cleared faults:";
+  for(Fault::Item fault : ~latched) {
+    std::cout << " " << Fault::itemName(fault);
+  }
+  std::cout << std::endl;
+
+  std::cout << std::endl;
+
+  // Per fault counters
+  RH_EnumMap<Fault, int> counts;
+  for(Fault::Item fault : latched) ++counts[fault];
+  ++counts[Fault::Item::underVoltage];
+
+  for(const auto& entry : counts) {
+    std::cout << entry.name << " = " << entry.value << std::endl;
+  }
+}
+
+// Emacs, here are file hints.
+// Local Variables:
+// compile-command: "g++ -std=c++17 -Wall -g -ggdb RH_ENUM_SET_MAP_demo.cxx -o RH_ENUM_SET_MAP_demo"
+// End:
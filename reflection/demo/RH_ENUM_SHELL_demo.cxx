@@ -1,5 +1,5 @@
 // Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
-// compile: g++ -std=c++14 -Wall -g -ggdb RH_ENUM_SHELL_demo.cxx -o RH_ENUM_SHELL_demo -I../../server
+// compile: g++ -std=c++17 -Wall -g -ggdb RH_ENUM_SHELL_demo.cxx -o RH_ENUM_SHELL_demo -I../../server
 
 #include <iostream>
 
@@ -25,7 +25,7 @@ int main(int argc, char **argv) {
   SmokeyStover smokeyStover = SmokeyStover::qux;
   std::cout << "enum item for smokeyStover = "
             << smokeyStover << " is ";
-  // Getting std::string name from enum value
+  // Getting std::string_view name from enum value
   std::cout << smokeyStover.itemName() << std::endl;
 
   std::cout << std::endl;
@@ -34,7 +34,7 @@ int main(int argc, char **argv) {
   smokeyStover = "initial";
   std::cout << "First enum item for smokeyStover = "
             << smokeyStover << " is ";
-  // Getting first std::string name from enum value
+  // Getting first std::string_view name from enum value
   std::cout << smokeyStover.itemName() << std::endl;
 
   {
@@ -54,5 +54,5 @@ int main(int argc, char **argv) {
 
 // Emacs, here are file hints.
 // Local Variables:
-// compile-command: "g++ -std=c++14 -Wall -g -ggdb RH_ENUM_SHELL_demo.cxx -o RH_ENUM_SHELL_demo -I../../server"
+// compile-command: "g++ -std=c++17 -Wall -g -ggdb RH_ENUM_SHELL_demo.cxx -o RH_ENUM_SHELL_demo -I../../server"
 // End:
@@ -0,0 +1,169 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+// compile: g++ -std=c++17 -O2 -Wall RH_ENUM_SHELL_lookup_benchmark.cxx -o RH_ENUM_SHELL_lookup_benchmark
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../RH_ENUM_SHELL.hpp"
+
+// Compares RH_ENUM_SHELL table lookups (name hash, dense value table)
+// with the linear scans they replaced, for 10, 100 and 300 item enums.
+
+RH_ENUM_CLASS_SHELL(
+  Enum10,
+  status000, status001, status002, status003, status004, status005, status006,
+  status007, status008, status009);
+
+RH_ENUM_CLASS_SHELL(
+  Enum100,
+  channel000, channel001, channel002, channel003, channel004, channel005,
+  channel006, channel007, channel008, channel009, channel010, channel011,
+  channel012, channel013, channel014, channel015, channel016, channel017,
+  channel018, channel019, channel020, channel021, channel022, channel023,
+  channel024, channel025, channel026, channel027, channel028, channel029,
+  channel030, channel031, channel032, channel033, channel034, channel035,
+  channel036, channel037, channel038, channel039, channel040, channel041,
+  channel042, channel043, channel044, channel045, channel046, channel047,
+  channel048, channel049, channel050, channel051, channel052, channel053,
+  channel054, channel055, channel056, channel057, channel058, channel059,
+  channel060, channel061, channel062, channel063, channel064, channel065,
+  channel066, channel067, channel068, channel069, channel070, channel071,
+  channel072, channel073, channel074, channel075, channel076, channel077,
+  channel078, channel079, channel080, channel081, channel082, channel083,
+  channel084, channel085, channel086, channel087, channel088, channel089,
+  channel090, channel091, channel092, channel093, channel094, channel095,
+  channel096, channel097, channel098, channel099);
+
+// Sparse values exercise the hashed value table.
+RH_ENUM_CLASS_SHELL(
+  Enum300,
+  fault000, fault001, fault002, fault003, fault004, fault005, fault006,
+  fault007, fault008, fault009, fault010, fault011, fault012, fault013,
+  fault014, fault015, fault016, fault017, fault018, fault019, fault020,
+  fault021, fault022, fault023, fault024, fault025, fault026, fault027,
+  fault028, fault029, fault030, fault031, fault032, fault033, fault034,
+  fault035, fault036, fault037, fault038, fault039, fault040, fault041,
+  fault042, fault043, fault044, fault045, fault046, fault047, fault048,
+  fault049, fault050, fault051, fault052, fault053, fault054, fault055,
+  fault056, fault057, fault058, fault059, fault060, fault061, fault062,
+  fault063, fault064, fault065, fault066, fault067, fault068, fault069,
+  fault070, fault071, fault072, fault073, fault074, fault075, fault076,
+  fault077, fault078, fault079, fault080, fault081, fault082, fault083,
+  fault084, fault085, fault086, fault087, fault088, fault089, fault090,
+  fault091, fault092, fault093, fault094, fault095, fault096, fault097,
+  fault098, fault099, fault100, fault101, fault102, fault103, fault104,
+  fault105, fault106, fault107, fault108, fault109, fault110, fault111,
+  fault112, fault113, fault114, fault115, fault116, fault117, fault118,
+  fault119, fault120, fault121, fault122, fault123, fault124, fault125,
+  fault126, fault127, fault128, fault129, fault130, fault131, fault132,
+  fault133, fault134, fault135, fault136, fault137, fault138, fault139,
+  fault140, fault141, fault142, fault143, fault144, fault145, fault146,
+  fault147, fault148, fault149, fault150, fault151, fault152, fault153,
+  fault154, fault155, fault156, fault157, fault158, fault159, fault160,
+  fault161, fault162, fault163, fault164, fault165, fault166, fault167,
+  fault168, fault169, fault170, fault171, fault172, fault173, fault174,
+  fault175, fault176, fault177, fault178, fault179, fault180, fault181,
+  fault182, fault183, fault184, fault185, fault186, fault187, fault188,
+  fault189, fault190, fault191, fault192, fault193, fault194, fault195,
+  fault196, fault197, fault198, fault199, fault200, fault201, fault202,
+  fault203, fault204, fault205, fault206, fault207, fault208, fault209,
+  fault210, fault211, fault212, fault213, fault214, fault215, fault216,
+  fault217, fault218, fault219, fault220, fault221, fault222, fault223,
+  fault224, fault225, fault226, fault227, fault228, fault229, fault230,
+  fault231, fault232, fault233, fault234, fault235, fault236, fault237,
+  fault238, fault239, fault240, fault241, fault242, fault243, fault244,
+  fault245, fault246, fault247, fault248, fault249, fault250, fault251,
+  fault252, fault253, fault254, fault255, fault256, fault257, fault258,
+  fault259, fault260, fault261, fault262, fault263, fault264, fault265,
+  fault266, fault267, fault268, fault269, fault270, fault271, fault272,
+  fault273, fault274, fault275, fault276, fault277, fault278, fault279,
+  fault280, fault281, fault282, fault283, fault284, fault285, fault286,
+  fault287, fault288, fault289, fault290, fault291, fault292, fault293,
+  fault294, fault295, fault296, fault297, fault298, fault299 = 0x10000);
+
+template<typename Shell>
+int linearIndexByName(const std::vector<std::string>& names,
+                      const char* name) {
+  for(int i = 0; i < Shell::itemsCount(); ++i) {
+    if(std::strcmp(names[i].c_str(), name) == 0) return i;
+  }
+  return -1;
+}
+
+template<typename Shell>
+int linearIndexByValue(typename Shell::Item item) {
+  for(int i = 0; i < Shell::itemsCount(); ++i) {
+    if(Shell::itemValue(i) == item) return i;
+  }
+  return -1;
+}
+
+template<typename F>
+double nanoSecondsPerCall(size_t calls, F&& f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         static_cast<double>(calls);
+}
+
+template<typename Shell>
+void benchmark() {
+  constexpr size_t queriesCount = 1 << 20;
+
+  std::vector<std::string> names;
+  for(int i = 0; i < Shell::itemsCount(); ++i) {
+    names.emplace_back(Shell::itemName(i));
+  }
+
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> distribution(0, Shell::itemsCount() - 1);
+  std::vector<const char*> nameQueries;
+  std::vector<typename Shell::Item> valueQueries;
+  for(size_t i = 0; i < queriesCount; ++i) {
+    int index = distribution(random);
+    nameQueries.push_back(names[index].c_str());
+    valueQueries.push_back(Shell::itemValue(index));
+  }
+
+  volatile long long checksum = 0;
+  double nameTable = nanoSecondsPerCall(queriesCount, [&] {
+    for(const char* name : nameQueries) checksum += Shell::itemIndex(name);
+  });
+  double nameLinear = nanoSecondsPerCall(queriesCount, [&] {
+    for(const char* name : nameQueries) {
+      checksum += linearIndexByName<Shell>(names, name);
+    }
+  });
+  double valueTable = nanoSecondsPerCall(queriesCount, [&] {
+    for(auto item : valueQueries) checksum += Shell::itemIndex(item);
+  });
+  double valueLinear = nanoSecondsPerCall(queriesCount, [&] {
+    for(auto item : valueQueries) {
+      checksum += linearIndexByValue<Shell>(item);
+    }
+  });
+
+  std::cout << Shell::itemsEnumReflectedName()
+            << " (" << Shell::itemsCount() << " items), ns per lookup:"
+            << std::endl
+            << "  name  -> index: table " << nameTable
+            << ", linear " << nameLinear << std::endl
+            << "  value -> index: table " << valueTable
+            << ", linear " << valueLinear << std::endl;
+}
+
+int main(int argc, char **argv) {
+  benchmark<Enum10>();
+  benchmark<Enum100>();
+  benchmark<Enum300>();
+}
+
+// Emacs, here are file hints.
+// Local Variables:
+// compile-command: "g++ -std=c++17 -O2 -Wall RH_ENUM_SHELL_lookup_benchmark.cxx -o RH_ENUM_SHELL_lookup_benchmark"
+// End:
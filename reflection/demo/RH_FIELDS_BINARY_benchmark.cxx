@@ -0,0 +1,130 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+// compile: g++ -std=c++17 -O2 -Wall RH_FIELDS_BINARY_benchmark.cxx -o RH_FIELDS_BINARY_benchmark -lboost_serialization
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/array_wrapper.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include "../RH_FIELDS_BINARY.hpp"
+
+// Compares RH_FIELDS binary snapshots with boost binary archives for a
+// small signal sample record and a record carrying a block of samples.
+
+class Sample {
+ public:
+  int64_t m_time;
+  double m_value;
+  uint32_t m_quality;
+  uint32_t m_channel;
+
+  RH_FIELDS(Sample, m_time, m_value, m_quality, m_channel)
+
+  template<class Archive>
+  void serialize(Archive& archive, const unsigned int) {
+    archive & m_time & m_value & m_quality & m_channel;
+  }
+};
+
+class Block {
+ public:
+  std::string m_name;
+  int64_t m_begin;
+  int64_t m_end;
+  std::vector<double> m_values;
+
+  RH_FIELDS(Block, m_name, m_begin, m_end, m_values)
+
+  template<class Archive>
+  void serialize(Archive& archive, const unsigned int) {
+    archive & m_name & m_begin & m_end & m_values;
+  }
+};
+
+// Best of a few passes, so first touch page faults and allocations of
+// the output buffers are not what gets measured.
+template<typename F>
+double nanoSecondsPerCall(size_t calls, F&& f) {
+  double best = 0;
+  for(int pass = 0; pass < 5; ++pass) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double, std::nano>(
+      stop - start).count() / static_cast<double>(calls);
+    if(pass == 0 || elapsed < best) best = elapsed;
+  }
+  return best;
+}
+
+template<typename T>
+void benchmark(const char* name, const std::vector<T>& objects) {
+  const size_t count = objects.size();
+
+  RH_BinaryWriter::Buffer buffer;
+  double fieldsWrite = nanoSecondsPerCall(count, [&] {
+    buffer.clear();
+    RH_BinaryWriter writer(buffer);
+    for(const T& object : objects) writer.write(object);
+  });
+  std::vector<T> fieldsObjects(count);
+  double fieldsRead = nanoSecondsPerCall(count, [&] {
+    RH_BinaryReader reader(buffer);
+    for(T& object : fieldsObjects) reader.read(object);
+  });
+
+  std::stringstream stream;
+  double boostWrite = nanoSecondsPerCall(count, [&] {
+    stream.str(std::string());
+    boost::archive::binary_oarchive archive(
+      stream, boost::archive::no_header);
+    for(const T& object : objects) archive << object;
+  });
+  std::vector<T> boostObjects(count);
+  double boostRead = nanoSecondsPerCall(count, [&] {
+    stream.seekg(0);
+    boost::archive::binary_iarchive archive(
+      stream, boost::archive::no_header);
+    for(T& object : boostObjects) archive >> object;
+  });
+
+  std::cout << name << " (" << count << " records), ns per record:"
+            << std::endl
+            << "  write: RH_FIELDS " << fieldsWrite
+            << ", boost " << boostWrite << std::endl
+            << "  read : RH_FIELDS " << fieldsRead
+            << ", boost " << boostRead << std::endl
+            << "  bytes: RH_FIELDS " << buffer.size()
+            << ", boost " << stream.str().size() << std::endl;
+}
+
+int main(int argc, char **argv) {
+  std::vector<Sample> samples(1 << 20);
+  for(size_t i = 0; i < samples.size(); ++i) {
+    samples[i] = Sample{static_cast<int64_t>(i), i * 0.5,
+                        static_cast<uint32_t>(i & 3),
+                        static_cast<uint32_t>(i % 17)};
+  }
+  benchmark("Sample", samples);
+
+  std::vector<Block> blocks(1 << 12);
+  for(size_t i = 0; i < blocks.size(); ++i) {
+    blocks[i].m_name = "channel" + std::to_string(i % 17);
+    blocks[i].m_begin = static_cast<int64_t>(i * 256);
+    blocks[i].m_end = blocks[i].m_begin + 256;
+    blocks[i].m_values.assign(256, i * 0.25);
+  }
+  benchmark("Block", blocks);
+}
+
+// Emacs, here are file hints.
+// Local Variables:
+// compile-command: "g++ -std=c++17 -O2 -Wall RH_FIELDS_BINARY_benchmark.cxx -o RH_FIELDS_BINARY_benchmark -lboost_serialization"
+// End:
@@ -0,0 +1,103 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+// compile: g++ -std=c++17 -O2 -Wall RH_FIELDS_TEXT_benchmark.cxx -o RH_FIELDS_TEXT_benchmark
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../RH_FIELDS_TEXT.hpp"
+
+// Measures RH_FIELDS JSON and CSV throughput on processor result like
+// records, writing into one fixed buffer and parsing it back.
+
+enum class Quality : uint8_t { good, uncertain, bad };
+
+class Result {
+ public:
+  int64_t m_time = 0;
+  double m_value = 0;
+  double m_minimum = 0;
+  double m_maximum = 0;
+  Quality m_quality = Quality::good;
+  uint32_t m_samplesCount = 0;
+  std::string m_channel;
+
+  RH_FIELDS(Result, m_time, m_value, m_minimum, m_maximum, m_quality,
+            m_samplesCount, m_channel)
+};
+
+// Best of a few passes, in MB of text per second.
+template<typename F>
+double megaBytesPerSecond(size_t bytes, F&& f) {
+  double best = 0;
+  for(int pass = 0; pass < 5; ++pass) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(stop - start).count();
+    if(bytes / seconds > best) best = bytes / seconds;
+  }
+  return best / 1e6;
+}
+
+int main(int argc, char **argv) {
+  std::vector<Result> results(1 << 18);
+  for(size_t i = 0; i < results.size(); ++i) {
+    Result& result = results[i];
+    result.m_time = 1700000000000 + static_cast<int64_t>(i) * 10;
+    result.m_value = 230.0 + (i % 1000) * 0.017;
+    result.m_minimum = result.m_value - 1.25;
+    result.m_maximum = result.m_value + 2.5;
+    result.m_quality = static_cast<Quality>(i % 3);
+    result.m_samplesCount = static_cast<uint32_t>(i % 512);
+    result.m_channel = "voltage/phase" + std::to_string(i % 3);
+  }
+
+  std::vector<char> buffer(results.size() * 256);
+  RH_TextWriter writer(buffer.data(), buffer.size());
+
+  auto writeJson = [&] {
+    writer.clear();
+    for(const Result& result : results) {
+      writer.writeJson(result);
+      writer.write("\n");
+    }
+  };
+  writeJson();
+  const std::string json(writer.view());
+  double jsonWrite = megaBytesPerSecond(json.size(), writeJson);
+
+  std::vector<Result> parsed(results.size());
+  double jsonRead = megaBytesPerSecond(json.size(), [&] {
+    RH_JsonParser parser(json);
+    for(Result& result : parsed) parser.read(result);
+  });
+
+  auto writeCsv = [&] {
+    writer.clear();
+    writer.writeCsvHeader<Result>();
+    for(const Result& result : results) writer.writeCsvRow(result);
+  };
+  writeCsv();
+  const std::string csv(writer.view());
+  double csvWrite = megaBytesPerSecond(csv.size(), writeCsv);
+
+  double csvRead = megaBytesPerSecond(csv.size(), [&] {
+    RH_CsvParser<Result> parser(csv);
+    for(Result& result : parsed) parser.read(result);
+  });
+
+  std::cout << results.size() << " records, MB/s:" << std::endl
+            << "  JSON, " << json.size() / results.size()
+            << " bytes per record: write " << jsonWrite
+            << ", parse " << jsonRead << std::endl
+            << "  CSV,  " << csv.size() / results.size()
+            << " bytes per record: write " << csvWrite
+            << ", parse " << csvRead << std::endl;
+}
+
+// Emacs, here are file hints.
+// Local Variables:
+// compile-command: "g++ -std=c++17 -O2 -Wall RH_FIELDS_TEXT_benchmark.cxx -o RH_FIELDS_TEXT_benchmark"
+// End:
@@ -0,0 +1,33 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+#ifndef __BitCast_hpp__
+#define __BitCast_hpp__
+
+#include <cstring>
+#include <type_traits>
+
+namespace rh {
+
+namespace signal_processors {
+
+// The bits of a value as another type of the same size, C++20's
+// std::bit_cast; e.g. doubles stored in std::atomic<uint64_t> words:
+//
+//   word.store(bitCast<uint64_t>(value), std::memory_order_relaxed);
+//   double value = bitCast<double>(word.load(std::memory_order_relaxed));
+template<typename To, typename From>
+inline To bitCast(const From& from) noexcept {
+  static_assert(sizeof(To) == sizeof(From),
+                "bitCast: types must have the same size");
+  static_assert(std::is_trivially_copyable<To>::value &&
+                std::is_trivially_copyable<From>::value,
+                "bitCast: types must be trivially copyable");
+  To to;
+  std::memcpy(&to, &from, sizeof(to));
+  return to;
+}
+
+} // namespace signal_processors
+
+} // namespace rh
+
+#endif // __BitCast_hpp__
@@ -0,0 +1,378 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+#ifndef __ChannelScheduler_hpp__
+#define __ChannelScheduler_hpp__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <boost/signals2.hpp>
+
+#include "debug/RH_PROFILE.hpp"
+#include "debug/RH_TRACE.hpp"
+#include "function/RH_FUNCTION.hpp"
+
+#include "DataStreams.hpp"
+
+namespace rh {
+
+namespace signal_processors {
+
+// Runs the processor chains of many DataStreams on a pool of workers
+// instead of the threads emitting their transactions:
+//
+//   ChannelScheduler scheduler({8, {0, 1, 2, 3, 4, 5, 6, 7}});
+//   scheduler.add(dataStream,
+//                 [&chain](DataStream::ConstBufferAsDoubleSPtr buffer,
+//                          double bufferTimeMilliSecond) {...});
+//
+// Each emitAsDouble transaction is queued on its channel, and a channel
+// with transactions queued is a task on a worker's deque. A worker runs
+// a task by passing up to batchTransactions of them to the chain in
+// order, then puts it back when more came meanwhile; a channel is on one
+// deque at a time, so its transactions never run concurrently or out of
+// order. Idle workers steal tasks from the others', so a few busy 1 MHz
+// channels spread over the pool while the 10 Hz ones fill the gaps.
+//
+// A channel goes back to the worker that ran it last, unless stolen, so
+// its chain's state stays in that worker's cache; with workers pinned to
+// cpus, memory the chain allocates and first touches is on their NUMA
+// node. Buffers come from the emitting threads, wherever they run.
+class ChannelScheduler {
+ public:
+  struct Options {
+    size_t workersCount = std::thread::hardware_concurrency();
+
+    // Worker i runs on cpus[i % cpus.size()]; none pins no worker.
+    std::vector<int> cpus;
+
+    size_t batchTransactions = 16;
+  };
+
+  using ChannelFunction = RH_InplaceFunction<
+    void(DataStream::ConstBufferAsDoubleSPtr bufferAsDoubleSPtr,
+         double bufferTimeMilliSecond)
+  >;
+
+  class Channel {
+   public:
+    // Transactions queued, not run yet.
+    size_t queueDepth() const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_transactions.size();
+    }
+
+    uint64_t executedCount() const {
+      return m_executedCount.load(std::memory_order_relaxed);
+    }
+
+   private:
+    friend class ChannelScheduler;
+
+    struct Transaction {
+      DataStream::ConstBufferAsDoubleSPtr bufferAsDoubleSPtr;
+      double bufferTimeMilliSecond;
+    };
+
+    Channel(ChannelFunction function, size_t homeWorker)
+        : m_function(std::move(function)),
+          m_homeWorker(homeWorker)
+    {}
+
+    ChannelFunction m_function;
+
+    mutable std::mutex m_mutex;
+    std::deque<Transaction> m_transactions;
+
+    // Whether on a deque or running; a worker clearing it checks the
+    // queue again.
+    std::atomic<bool> m_scheduled{false};
+    std::atomic<size_t> m_homeWorker;
+    std::atomic<uint64_t> m_executedCount{0};
+
+    boost::signals2::scoped_connection m_connection;
+  };
+
+  struct WorkerMetrics {
+    // Channels with transactions waiting on the worker's deque.
+    size_t queueDepth;
+    uint64_t executedCount;
+    uint64_t stealsCount;
+  };
+
+  ChannelScheduler();
+  explicit ChannelScheduler(Options options);
+
+  // Disconnects the channels, waits for the emissions enqueueing on
+  // them and returns once the workers ran the transactions queued.
+  ~ChannelScheduler();
+
+  ChannelScheduler(const ChannelScheduler&) = delete;
+  ChannelScheduler& operator=(const ChannelScheduler&) = delete;
+
+  // The channel lives as long as the scheduler.
+  Channel& add(DataStream& dataStream, ChannelFunction function);
+
+  size_t workersCount() const {
+    return m_workers.size();
+  }
+
+  std::vector<WorkerMetrics> workerMetrics() const;
+
+ private:
+  struct Worker {
+    mutable std::mutex mutex;
+    std::deque<Channel*> channels;
+    std::atomic<uint64_t> executedCount{0};
+    std::atomic<uint64_t> stealsCount{0};
+    std::thread thread;
+  };
+
+  void enqueue(
+    Channel& channel,
+    DataStream::ConstBufferAsDoubleSPtr bufferAsDoubleSPtr,
+    double bufferTimeMilliSecond
+  );
+
+  // To the current thread's worker when it is one, else to the
+  // channel's home worker.
+  void schedule(Channel& channel);
+
+  Channel* pop(size_t worker);
+  Channel* steal(size_t worker);
+  void run(size_t worker, Channel& channel);
+  void work(size_t worker);
+
+  const size_t m_batchTransactions;
+  std::vector<std::unique_ptr<Worker>> m_workers;
+
+  std::mutex m_channelsMutex;
+  std::vector<std::unique_ptr<Channel>> m_channels;
+
+  // Tracked by the channels' connections, so emissions calling them hold
+  // it and none calls them once it expired.
+  std::shared_ptr<char> m_alive = std::make_shared<char>();
+
+  // Channels on the deques, and the workers sleeping for lack of them.
+  std::atomic<size_t> m_queuedCount{0};
+  std::atomic<size_t> m_sleepersCount{0};
+  std::mutex m_sleepMutex;
+  std::condition_variable m_wake;
+  std::atomic<bool> m_stopping{false};
+};
+
+inline ChannelScheduler::ChannelScheduler()
+    : ChannelScheduler(Options{})
+{}
+
+inline ChannelScheduler::ChannelScheduler(Options options)
+    : m_batchTransactions{std::max<size_t>(options.batchTransactions, 1)}
+{
+  const size_t workersCount = std::max<size_t>(options.workersCount, 1);
+  for(size_t i = 0; i < workersCount; ++i) {
+    m_workers.emplace_back(new Worker);
+  }
+  // Pinned before working, so what they touch first is on their node.
+  for(size_t i = 0; i < workersCount; ++i) {
+    const int cpu = options.cpus.empty()
+      ? -1
+      : options.cpus[i % options.cpus.size()];
+    m_workers[i]->thread = std::thread([this, i, cpu] {
+      if(cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+      }
+      work(i);
+    });
+  }
+}
+
+inline ChannelScheduler::~ChannelScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(m_channelsMutex);
+    for(auto& channel : m_channels) channel->m_connection.disconnect();
+  }
+  std::weak_ptr<char> alive = m_alive;
+  m_alive.reset();
+  while(!alive.expired()) std::this_thread::yield();
+  {
+    std::lock_guard<std::mutex> lock(m_sleepMutex);
+    m_stopping.store(true);
+  }
+  m_wake.notify_all();
+  for(auto& worker : m_workers) worker->thread.join();
+}
+
+inline ChannelScheduler::Channel& ChannelScheduler::add(
+  DataStream& dataStream,
+  ChannelFunction function
+) {
+  std::lock_guard<std::mutex> lock(m_channelsMutex);
+  m_channels.emplace_back(
+    new Channel(std::move(function), m_channels.size() % m_workers.size()));
+  Channel& channel = *m_channels.back();
+  channel.m_connection = dataStream.emitAsDouble.connect(
+    DataStream::EmitAsDoubleSignal::slot_type(
+      [this, &channel](DataStream::ConstBufferAsDoubleSPtr bufferAsDoubleSPtr,
+                       double bufferTimeMilliSecond) {
+        enqueue(channel, std::move(bufferAsDoubleSPtr),
+                bufferTimeMilliSecond);
+      }
+    ).track_foreign(std::weak_ptr<char>(m_alive)));
+  return channel;
+}
+
+inline std::vector<ChannelScheduler::WorkerMetrics>
+ChannelScheduler::workerMetrics() const {
+  std::vector<WorkerMetrics> metrics;
+  metrics.reserve(m_workers.size());
+  for(const auto& worker : m_workers) {
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    metrics.push_back(WorkerMetrics{
+      worker->channels.size(),
+      worker->executedCount.load(std::memory_order_relaxed),
+      worker->stealsCount.load(std::memory_order_relaxed)});
+  }
+  return metrics;
+}
+
+inline void ChannelScheduler::enqueue(
+  Channel& channel,
+  DataStream::ConstBufferAsDoubleSPtr bufferAsDoubleSPtr,
+  double bufferTimeMilliSecond
+) {
+  {
+    std::lock_guard<std::mutex> lock(channel.m_mutex);
+    channel.m_transactions.push_back(
+      Channel::Transaction{std::move(bufferAsDoubleSPtr),
+                           bufferTimeMilliSecond});
+  }
+  if(!channel.m_scheduled.exchange(true)) schedule(channel);
+}
+
+namespace channel_scheduler {
+
+// Of the workers' threads: their scheduler and index.
+struct CurrentWorker {
+  const void* scheduler = nullptr;
+  size_t index = 0;
+};
+
+inline thread_local CurrentWorker currentWorker;
+
+} // namespace channel_scheduler
+
+inline void ChannelScheduler::schedule(Channel& channel) {
+  const channel_scheduler::CurrentWorker& current =
+    channel_scheduler::currentWorker;
+  const size_t worker = current.scheduler == this
+    ? current.index
+    : channel.m_homeWorker.load(std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(m_workers[worker]->mutex);
+    m_workers[worker]->channels.push_back(&channel);
+    // Sequentially consistent with the sleepers' count and check, so
+    // that no worker sleeps through it.
+    m_queuedCount.fetch_add(1);
+  }
+  if(m_sleepersCount.load() > 0) {
+    { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+    m_wake.notify_one();
+  }
+}
+
+inline ChannelScheduler::Channel* ChannelScheduler::pop(size_t worker) {
+  Worker& self = *m_workers[worker];
+  std::lock_guard<std::mutex> lock(self.mutex);
+  if(self.channels.empty()) return nullptr;
+  Channel* channel = self.channels.front();
+  self.channels.pop_front();
+  m_queuedCount.fetch_sub(1);
+  return channel;
+}
+
+// From the back of the others' deques, the channels they would run last.
+inline ChannelScheduler::Channel* ChannelScheduler::steal(size_t worker) {
+  for(size_t i = 1; i < m_workers.size(); ++i) {
+    if(m_queuedCount.load() == 0) return nullptr;
+    Worker& victim = *m_workers[(worker + i) % m_workers.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if(victim.channels.empty()) continue;
+    Channel* channel = victim.channels.back();
+    victim.channels.pop_back();
+    m_queuedCount.fetch_sub(1);
+    m_workers[worker]->stealsCount.fetch_add(1, std::memory_order_relaxed);
+    return channel;
+  }
+  return nullptr;
+}
+
+inline void ChannelScheduler::run(size_t worker, Channel& channel) {
+  RH_PROFILE_ZONE;
+  channel.m_homeWorker.store(worker, std::memory_order_relaxed);
+  for(size_t i = 0; i < m_batchTransactions; ++i) {
+    Channel::Transaction transaction;
+    {
+      std::lock_guard<std::mutex> lock(channel.m_mutex);
+      if(channel.m_transactions.empty()) break;
+      transaction = std::move(channel.m_transactions.front());
+      channel.m_transactions.pop_front();
+    }
+    channel.m_function(std::move(transaction.bufferAsDoubleSPtr),
+                       transaction.bufferTimeMilliSecond);
+    channel.m_executedCount.fetch_add(1, std::memory_order_relaxed);
+    m_workers[worker]->executedCount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Back on the deque while transactions are queued; otherwise
+  // unscheduled, unless one came in before that and scheduled it anew.
+  bool queued;
+  {
+    std::lock_guard<std::mutex> lock(channel.m_mutex);
+    queued = !channel.m_transactions.empty();
+  }
+  if(!queued) {
+    channel.m_scheduled.store(false);
+    std::lock_guard<std::mutex> lock(channel.m_mutex);
+    queued = !channel.m_transactions.empty() &&
+             !channel.m_scheduled.exchange(true);
+  }
+  if(queued) schedule(channel);
+}
+
+inline void ChannelScheduler::work(size_t worker) {
+  channel_scheduler::currentWorker = {this, worker};
+  for(;;) {
+    Channel* channel = pop(worker);
+    if(!channel) channel = steal(worker);
+    if(channel) {
+      run(worker, *channel);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_sleepMutex);
+    m_sleepersCount.fetch_add(1);
+    m_wake.wait(lock, [this] {
+      return m_queuedCount.load() > 0 || m_stopping.load();
+    });
+    m_sleepersCount.fetch_sub(1);
+    if(m_stopping.load() && m_queuedCount.load() == 0) return;
+  }
+}
+
+} // namespace signal_processors
+
+} // namespace rh
+
+#endif // __ChannelScheduler_hpp__
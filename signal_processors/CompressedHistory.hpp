@@ -0,0 +1,610 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+#ifndef __CompressedHistory_hpp__
+#define __CompressedHistory_hpp__
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "debug/RH_PROFILE.hpp"
+#include "debug/RH_TRACE.hpp"
+
+#include "BitCast.hpp"
+
+namespace rh {
+
+namespace signal_processors {
+
+// Bits appended to 64 bit words, most significant first.
+class BitWriter {
+ public:
+  explicit BitWriter(std::vector<uint64_t>& words)
+      : m_words(words)
+  {}
+
+  // The low bitsCount bits of bits, 1 to 64 of them.
+  void write(uint64_t bits, unsigned bitsCount) {
+    if(bitsCount < 64) bits &= (uint64_t(1) << bitsCount) - 1;
+    if(m_freeBitsCount == 0) {
+      m_words.push_back(0);
+      m_freeBitsCount = 64;
+    }
+    if(bitsCount <= m_freeBitsCount) {
+      m_freeBitsCount -= bitsCount;
+      m_words.back() |= bits << m_freeBitsCount;
+    }
+    else {
+      const unsigned restBitsCount = bitsCount - m_freeBitsCount;
+      m_words.back() |= bits >> restBitsCount;
+      m_freeBitsCount = 64 - restBitsCount;
+      m_words.push_back(bits << m_freeBitsCount);
+    }
+  }
+
+ private:
+  std::vector<uint64_t>& m_words;
+  unsigned m_freeBitsCount = 0;
+};
+
+// Bits of a BitWriter's words, in the order written.
+class BitReader {
+ public:
+  BitReader(const uint64_t* words, size_t wordsCount)
+      : m_words(words),
+        m_wordsCount(wordsCount)
+  {}
+
+  // The next 64 bits, zeros past the end.
+  uint64_t peek() const {
+    const size_t word = m_bitIndex >> 6;
+    const unsigned offset = m_bitIndex & 63;
+    uint64_t bits = m_words[word] << offset;
+    if(offset != 0 && word + 1 < m_wordsCount) {
+      bits |= m_words[word + 1] >> (64 - offset);
+    }
+    return bits;
+  }
+
+  // bitsCount of 1 to 64 bits.
+  uint64_t read(unsigned bitsCount) {
+    const uint64_t bits = peek();
+    m_bitIndex += bitsCount;
+    return bits >> (64 - bitsCount);
+  }
+
+  // Count of leading one bits up to maxCount, and the zero ending them
+  // if fewer.
+  unsigned readOnes(unsigned maxCount) {
+    unsigned count = 0;
+    while(count < maxCount && read(1)) ++count;
+    return count;
+  }
+
+ private:
+  const uint64_t* m_words;
+  size_t m_wordsCount;
+  size_t m_bitIndex = 0;
+};
+
+// Block of compressed samples and their time points.
+struct CompressedBlock {
+  size_t samplesCount = 0;
+  std::vector<uint64_t> timePointsWords;
+  std::vector<uint64_t> valuesWords;
+
+  size_t bytes() const {
+    return sizeof(*this) +
+      (timePointsWords.capacity() + valuesWords.capacity()) *
+      sizeof(uint64_t);
+  }
+};
+
+// Block encoder and decoder of samples and double time points, after
+// Facebook's Gorilla:
+//
+//   time points  delta of delta of their bit patterns, which grow by a
+//                near constant step for evenly spaced doubles, in 1 bit
+//                when the spacing holds and 4 to 69 bits otherwise
+//   double and   XOR with the previous value's bits, in 1 bit for a
+//   float values repeat and in the meaningful XOR bits otherwise
+//   integer      zigzag deltas, bit packed per frame of 64 at the width
+//   values       of the frame's widest, for raw ADC counts
+//
+// All lossless, NaN payloads included.
+template<typename V>
+class SamplesCodec {
+ public:
+  using Value = V;
+
+  static_assert(std::is_floating_point_v<Value> || std::is_integral_v<Value>,
+                "SamplesCodec encodes floating point or integer values");
+  static_assert(sizeof(Value) <= sizeof(uint64_t),
+                "SamplesCodec encodes values of at most 64 bits");
+
+  static void encode(
+    const Value* values,
+    const double* timePoints,
+    size_t samplesCount,
+    CompressedBlock& block
+  );
+
+  // Decodes samplesCount of values and timePoints.
+  static void decode(
+    const CompressedBlock& block,
+    Value* values,
+    double* timePoints
+  );
+
+ private:
+  static constexpr size_t frameSamplesCount = 64;
+
+  static uint64_t zigzag(uint64_t delta) {
+    return (delta << 1) ^ (0 - (delta >> 63));
+  }
+
+  static uint64_t unzigzag(uint64_t value) {
+    return (value >> 1) ^ (0 - (value & 1));
+  }
+
+  static unsigned bitsWidth(uint64_t value) {
+    return value == 0 ? 0 : 64 - __builtin_clzll(value);
+  }
+
+  template<typename T>
+  static uint64_t bitsOf(T value) {
+    if constexpr(sizeof(T) == sizeof(uint64_t)) {
+      return bitCast<uint64_t>(value);
+    }
+    else if constexpr(std::is_floating_point_v<T>) {
+      return bitCast<uint32_t>(value);
+    }
+    else {
+      return static_cast<uint64_t>(static_cast<int64_t>(value));
+    }
+  }
+
+  template<typename T>
+  static T fromBits(uint64_t bits) {
+    if constexpr(sizeof(T) == sizeof(uint64_t)) {
+      return bitCast<T>(bits);
+    }
+    else if constexpr(std::is_floating_point_v<T>) {
+      return bitCast<T>(static_cast<uint32_t>(bits));
+    }
+    else {
+      return static_cast<T>(static_cast<int64_t>(bits));
+    }
+  }
+
+  static void encodeTimePoints(
+    const double* timePoints,
+    size_t samplesCount,
+    BitWriter& writer
+  );
+
+  static void decodeTimePoints(
+    double* timePoints,
+    size_t samplesCount,
+    BitReader& reader
+  );
+
+  static void encodeValues(
+    const Value* values,
+    size_t samplesCount,
+    BitWriter& writer
+  );
+
+  static void decodeValues(
+    Value* values,
+    size_t samplesCount,
+    BitReader& reader
+  );
+};
+
+template<typename V>
+inline void SamplesCodec<V>::encode(
+  const Value* values,
+  const double* timePoints,
+  size_t samplesCount,
+  CompressedBlock& block
+) {
+  RH_TRACE_SCOPE(samplesCount, 0);
+  RH_PROFILE_ZONE;
+  block.samplesCount = samplesCount;
+  block.timePointsWords.clear();
+  block.valuesWords.clear();
+  if(samplesCount == 0) return;
+
+  BitWriter timePointsWriter(block.timePointsWords);
+  encodeTimePoints(timePoints, samplesCount, timePointsWriter);
+  BitWriter valuesWriter(block.valuesWords);
+  encodeValues(values, samplesCount, valuesWriter);
+  block.timePointsWords.shrink_to_fit();
+  block.valuesWords.shrink_to_fit();
+}
+
+template<typename V>
+inline void SamplesCodec<V>::decode(
+  const CompressedBlock& block,
+  Value* values,
+  double* timePoints
+) {
+  RH_TRACE_SCOPE(block.samplesCount, 0);
+  RH_PROFILE_ZONE;
+  if(block.samplesCount == 0) return;
+
+  BitReader timePointsReader(block.timePointsWords.data(),
+                             block.timePointsWords.size());
+  decodeTimePoints(timePoints, block.samplesCount, timePointsReader);
+  BitReader valuesReader(block.valuesWords.data(), block.valuesWords.size());
+  decodeValues(values, block.samplesCount, valuesReader);
+}
+
+// Delta of delta classes by zigzag width: '0' for none, then '10', '110',
+// '1110' and '11110' with 2, 7, 12 and 32 bits, '11111' with 64. 2 bits
+// take the one ulp jitter of time points computed as start + i * step.
+template<typename V>
+inline void SamplesCodec<V>::encodeTimePoints(
+  const double* timePoints,
+  size_t samplesCount,
+  BitWriter& writer
+) {
+  uint64_t previous = bitsOf(timePoints[0]);
+  uint64_t previousDelta = 0;
+  writer.write(previous, 64);
+  for(size_t i = 1; i < samplesCount; ++i) {
+    const uint64_t current = bitsOf(timePoints[i]);
+    const uint64_t delta = current - previous;
+    const uint64_t deltaOfDelta = zigzag(delta - previousDelta);
+    if(deltaOfDelta == 0) writer.write(0, 1);
+    else if(deltaOfDelta < (uint64_t(1) << 2)) {
+      writer.write(0b10, 2);
+      writer.write(deltaOfDelta, 2);
+    }
+    else if(deltaOfDelta < (uint64_t(1) << 7)) {
+      writer.write(0b110, 3);
+      writer.write(deltaOfDelta, 7);
+    }
+    else if(deltaOfDelta < (uint64_t(1) << 12)) {
+      writer.write(0b1110, 4);
+      writer.write(deltaOfDelta, 12);
+    }
+    else if(deltaOfDelta < (uint64_t(1) << 32)) {
+      writer.write(0b11110, 5);
+      writer.write(deltaOfDelta, 32);
+    }
+    else {
+      writer.write(0b11111, 5);
+      writer.write(deltaOfDelta, 64);
+    }
+    previous = current;
+    previousDelta = delta;
+  }
+}
+
+template<typename V>
+inline void SamplesCodec<V>::decodeTimePoints(
+  double* timePoints,
+  size_t samplesCount,
+  BitReader& reader
+) {
+  static constexpr unsigned widths[] = {0, 2, 7, 12, 32, 64};
+  uint64_t previous = reader.read(64);
+  uint64_t previousDelta = 0;
+  timePoints[0] = fromBits<double>(previous);
+  for(size_t i = 1; i < samplesCount; ++i) {
+    const unsigned width = widths[reader.readOnes(5)];
+    const uint64_t deltaOfDelta = width == 0 ? 0 : reader.read(width);
+    previousDelta += unzigzag(deltaOfDelta);
+    previous += previousDelta;
+    timePoints[i] = fromBits<double>(previous);
+  }
+}
+
+// Floating point: '0' for a repeat, '10' and the XOR's meaningful bits
+// when they fit the previous ones' window, '11', 5 bits of leading zeros,
+// 6 bits of meaningful bits count less one and the bits otherwise.
+// Integers: per frame 7 bits of width and the frame's zigzag deltas.
+template<typename V>
+inline void SamplesCodec<V>::encodeValues(
+  const Value* values,
+  size_t samplesCount,
+  BitWriter& writer
+) {
+  uint64_t previous = bitsOf(values[0]);
+  writer.write(previous, 64);
+  if constexpr(std::is_floating_point_v<Value>) {
+    unsigned leading = 65;
+    unsigned trailing = 0;
+    for(size_t i = 1; i < samplesCount; ++i) {
+      const uint64_t current = bitsOf(values[i]);
+      const uint64_t xored = current ^ previous;
+      previous = current;
+      if(xored == 0) {
+        writer.write(0, 1);
+        continue;
+      }
+      unsigned currentLeading = __builtin_clzll(xored);
+      const unsigned currentTrailing = __builtin_ctzll(xored);
+      if(currentLeading > 31) currentLeading = 31;
+      if(leading <= currentLeading && trailing <= currentTrailing) {
+        writer.write(0b10, 2);
+        writer.write(xored >> trailing, 64 - leading - trailing);
+      }
+      else {
+        leading = currentLeading;
+        trailing = currentTrailing;
+        const unsigned meaningful = 64 - leading - trailing;
+        writer.write(0b11, 2);
+        writer.write(leading, 5);
+        writer.write(meaningful - 1, 6);
+        writer.write(xored >> trailing, meaningful);
+      }
+    }
+  }
+  else {
+    uint64_t deltas[frameSamplesCount];
+    for(size_t frame = 1; frame < samplesCount;
+        frame += frameSamplesCount) {
+      const size_t count =
+        std::min(frameSamplesCount, samplesCount - frame);
+      uint64_t widest = 0;
+      for(size_t i = 0; i < count; ++i) {
+        const uint64_t current = bitsOf(values[frame + i]);
+        deltas[i] = zigzag(current - previous);
+        widest |= deltas[i];
+        previous = current;
+      }
+      const unsigned width = bitsWidth(widest);
+      writer.write(width, 7);
+      if(width == 0) continue;
+      for(size_t i = 0; i < count; ++i) writer.write(deltas[i], width);
+    }
+  }
+}
+
+template<typename V>
+inline void SamplesCodec<V>::decodeValues(
+  Value* values,
+  size_t samplesCount,
+  BitReader& reader
+) {
+  uint64_t previous = reader.read(64);
+  values[0] = fromBits<Value>(previous);
+  if constexpr(std::is_floating_point_v<Value>) {
+    unsigned leading = 0;
+    unsigned trailing = 0;
+    for(size_t i = 1; i < samplesCount; ++i) {
+      const unsigned control = reader.readOnes(2);
+      if(control == 2) {
+        leading = reader.read(5);
+        trailing = 64 - leading - (reader.read(6) + 1);
+      }
+      if(control != 0) {
+        previous ^= reader.read(64 - leading - trailing) << trailing;
+      }
+      values[i] = fromBits<Value>(previous);
+    }
+  }
+  else {
+    for(size_t frame = 1; frame < samplesCount;
+        frame += frameSamplesCount) {
+      const size_t count =
+        std::min(frameSamplesCount, samplesCount - frame);
+      const unsigned width = reader.read(7);
+      for(size_t i = 0; i < count; ++i) {
+        if(width != 0) previous += unzigzag(reader.read(width));
+        values[frame + i] = fromBits<Value>(previous);
+      }
+    }
+  }
+}
+
+// History of a channel's samples and time points: the newest samples stay
+// as they come in an open block; a full block is sealed and waits for
+// compressSealed(), meant to be called from a background thread or timer
+// of the owner's choice, to be replaced by its CompressedBlock. Appends
+// from one thread, compressSealed() and reads from any.
+//
+//   history.append(*bufferAsDoubleSPtr, bufferTimeMilliSecond,
+//                  dataStream.samplingIntervalMilliSecond());
+template<typename V>
+class CompressedHistory {
+ public:
+  using Value = V;
+  using Codec = SamplesCodec<Value>;
+
+  explicit CompressedHistory(size_t blockSamplesCount = 4096)
+      : m_blockSamplesCount{blockSamplesCount}
+  {
+    if(m_blockSamplesCount == 0) {
+      throw std::invalid_argument(
+        "CompressedHistory: zero block samples count");
+    }
+    m_open = std::make_shared<RawBlock>();
+    m_open->reserve(m_blockSamplesCount);
+  }
+
+  void append(
+    const Value* values,
+    const double* timePoints,
+    size_t samplesCount
+  );
+
+  // Samples of a buffer, samplingInterval apart from bufferTimePoint on,
+  // as DataStream::emitAsDouble passes them.
+  void append(
+    const std::vector<Value>& buffer,
+    double bufferTimePoint,
+    double samplingInterval
+  );
+
+  // Compresses the blocks sealed so far and returns their count.
+  size_t compressSealed();
+
+  size_t samplesCount() const;
+
+  // Bytes of the samples and time points held, compressed or not.
+  size_t bytes() const;
+
+  // Calls f(const Value* values, const double* timePoints, size_t count)
+  // per block, oldest first, decoding compressed ones outside the lock.
+  template<typename F>
+  void forEach(F&& f) const;
+
+ private:
+  struct RawBlock {
+    std::vector<Value> values;
+    std::vector<double> timePoints;
+
+    void reserve(size_t samplesCount) {
+      values.reserve(samplesCount);
+      timePoints.reserve(samplesCount);
+    }
+
+    size_t bytes() const {
+      return sizeof(*this) + values.capacity() * sizeof(Value) +
+        timePoints.capacity() * sizeof(double);
+    }
+  };
+
+  using RawBlockSPtr = std::shared_ptr<RawBlock>;
+  using CompressedBlockSPtr = std::shared_ptr<const CompressedBlock>;
+
+  // Under m_mutex.
+  void seal();
+
+  const size_t m_blockSamplesCount;
+
+  mutable std::mutex m_mutex;
+  std::deque<CompressedBlockSPtr> m_compressed;
+  std::deque<RawBlockSPtr> m_sealed;
+  RawBlockSPtr m_open;
+  size_t m_samplesCount = 0;
+  size_t m_bytes = 0;
+
+  // Keeps concurrent compressSealed() calls in order.
+  std::mutex m_compressMutex;
+};
+
+template<typename V>
+inline void CompressedHistory<V>::append(
+  const Value* values,
+  const double* timePoints,
+  size_t samplesCount
+) {
+  RH_TRACE_SCOPE(samplesCount, 0);
+  RH_PROFILE_ZONE;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for(size_t i = 0; i < samplesCount;) {
+    const size_t count = std::min(
+      samplesCount - i, m_blockSamplesCount - m_open->values.size());
+    m_open->values.insert(m_open->values.end(), values + i,
+                          values + i + count);
+    m_open->timePoints.insert(m_open->timePoints.end(), timePoints + i,
+                              timePoints + i + count);
+    i += count;
+    m_samplesCount += count;
+    if(m_open->values.size() == m_blockSamplesCount) seal();
+  }
+}
+
+template<typename V>
+inline void CompressedHistory<V>::append(
+  const std::vector<Value>& buffer,
+  double bufferTimePoint,
+  double samplingInterval
+) {
+  constexpr size_t chunkSamplesCount = 256;
+  double timePoints[chunkSamplesCount];
+  for(size_t i = 0; i < buffer.size(); i += chunkSamplesCount) {
+    const size_t count = std::min(chunkSamplesCount, buffer.size() - i);
+    for(size_t j = 0; j < count; ++j) {
+      timePoints[j] = bufferTimePoint + (i + j) * samplingInterval;
+    }
+    append(buffer.data() + i, timePoints, count);
+  }
+}
+
+template<typename V>
+inline void CompressedHistory<V>::seal() {
+  m_bytes += m_open->bytes();
+  m_sealed.push_back(std::move(m_open));
+  m_open = std::make_shared<RawBlock>();
+  m_open->reserve(m_blockSamplesCount);
+}
+
+template<typename V>
+inline size_t CompressedHistory<V>::compressSealed() {
+  std::lock_guard<std::mutex> compressLock(m_compressMutex);
+  std::deque<RawBlockSPtr> sealed;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    sealed = m_sealed;
+  }
+
+  // Encoded outside the lock; a sealed block does not change any more.
+  for(const RawBlockSPtr& raw : sealed) {
+    auto block = std::make_shared<CompressedBlock>();
+    Codec::encode(raw->values.data(), raw->timePoints.data(),
+                  raw->values.size(), *block);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_bytes += block->bytes();
+    m_bytes -= raw->bytes();
+    m_compressed.push_back(std::move(block));
+    m_sealed.pop_front();
+  }
+  return sealed.size();
+}
+
+template<typename V>
+inline size_t CompressedHistory<V>::samplesCount() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_samplesCount;
+}
+
+template<typename V>
+inline size_t CompressedHistory<V>::bytes() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_bytes + m_open->bytes();
+}
+
+template<typename V>
+template<typename F>
+inline void CompressedHistory<V>::forEach(F&& f) const {
+  std::vector<CompressedBlockSPtr> compressed;
+  std::vector<RawBlockSPtr> sealed;
+  RawBlock open;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    compressed.assign(m_compressed.begin(), m_compressed.end());
+    sealed.assign(m_sealed.begin(), m_sealed.end());
+    open = *m_open;
+  }
+
+  RawBlock decoded;
+  for(const CompressedBlockSPtr& block : compressed) {
+    decoded.values.resize(block->samplesCount);
+    decoded.timePoints.resize(block->samplesCount);
+    Codec::decode(*block, decoded.values.data(), decoded.timePoints.data());
+    f(decoded.values.data(), decoded.timePoints.data(),
+      decoded.values.size());
+  }
+  for(const RawBlockSPtr& raw : sealed) {
+    f(raw->values.data(), raw->timePoints.data(), raw->values.size());
+  }
+  if(!open.values.empty()) {
+    f(open.values.data(), open.timePoints.data(), open.values.size());
+  }
+}
+
+} // namespace signal_processors
+
+} // namespace rh
+
+#endif // __CompressedHistory_hpp__
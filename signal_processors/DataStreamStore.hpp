@@ -0,0 +1,356 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+#ifndef __DataStreamStore_hpp__
+#define __DataStreamStore_hpp__
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/signals2.hpp>
+
+#include "debug/RH_PROFILE.hpp"
+#include "debug/RH_TRACE.hpp"
+
+#include "BitCast.hpp"
+#include "DataStreams.hpp"
+
+namespace rh {
+
+namespace signal_processors {
+
+// Ring of the last capacity records of WordsCount 64 bit words, written
+// by one thread and read by any without blocking it: a reader copies
+// records and then drops those the writer overwrote meanwhile, which it
+// tells from the count of records begun, published before the writer
+// touches a slot.
+template<size_t WordsCount>
+class SeqRing {
+ public:
+  using Record = uint64_t[WordsCount];
+
+  explicit SeqRing(size_t capacity)
+      : m_capacity{capacity},
+        m_words{new std::atomic<uint64_t>[capacity * WordsCount]}
+  {
+    if(m_capacity == 0) throw std::invalid_argument("SeqRing: zero capacity");
+    for(size_t i = 0; i < m_capacity * WordsCount; ++i) {
+      m_words[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  size_t capacity() const {
+    return m_capacity;
+  }
+
+  // Writer only.
+  void push(const Record& record) {
+    const uint64_t index = m_written.load(std::memory_order_relaxed);
+    m_begun.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::atomic<uint64_t>* words = slot(index);
+    for(size_t i = 0; i < WordsCount; ++i) {
+      words[i].store(record[i], std::memory_order_relaxed);
+    }
+    m_written.store(index + 1, std::memory_order_release);
+  }
+
+  // Index past the last record written; records from written() -
+  // capacity() on are retained.
+  uint64_t written() const {
+    return m_written.load(std::memory_order_acquire);
+  }
+
+  // Copies record index, which may be overwritten meanwhile; see validFrom().
+  void read(uint64_t index, Record& record) const {
+    const std::atomic<uint64_t>* words = slot(index);
+    for(size_t i = 0; i < WordsCount; ++i) {
+      record[i] = words[i].load(std::memory_order_relaxed);
+    }
+  }
+
+  // First index whose copies read() so far are intact.
+  uint64_t validFrom() const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t begun = m_begun.load(std::memory_order_relaxed);
+    return begun > m_capacity ? begun - m_capacity : 0;
+  }
+
+ private:
+  std::atomic<uint64_t>* slot(uint64_t index) const {
+    return &m_words[(index % m_capacity) * WordsCount];
+  }
+
+  const size_t m_capacity;
+  const std::unique_ptr<std::atomic<uint64_t>[]> m_words;
+  std::atomic<uint64_t> m_begun{0};
+  std::atomic<uint64_t> m_written{0};
+};
+
+// In-process history of a DataStream in three tiers of preallocated
+// rings: raw samples, 1 s aggregates and 1 min aggregates, each kept for
+// as many records as its capacity, so e.g. minutes, hours and days. It
+// subscribes to emitAsDouble and observes the stream's demand while it
+// exists; queries run on any thread and never block the stream.
+// The constructor throws std::invalid_argument for a zero capacity.
+class DataStreamStore {
+ public:
+  // Samples of timePoint on, up to the next resolution; a raw sample is
+  // an Aggregate of count 1. NaN samples are counted in no aggregate.
+  struct Aggregate {
+    double timePoint;
+    double min;
+    double max;
+    double mean;
+    uint64_t count;
+  };
+
+  enum class Tier {raw, second, minute};
+
+  static constexpr double secondResolution = 1000.0;
+  static constexpr double minuteResolution = 60000.0;
+
+  DataStreamStore(
+    DataStream& dataStream,
+    size_t rawCapacity,
+    size_t secondCapacity = 3 * 3600,
+    size_t minuteCapacity = 7 * 24 * 60
+  );
+
+  ~DataStreamStore() {
+    m_dataStream.demand.observerRemove();
+  }
+
+  DataStreamStore(const DataStreamStore&) = delete;
+  DataStreamStore& operator=(const DataStreamStore&) = delete;
+
+  // The coarsest tier at least as fine as resolution in milliseconds.
+  static Tier tier(double resolution) {
+    if(resolution >= minuteResolution) return Tier::minute;
+    if(resolution >= secondResolution) return Tier::second;
+    return Tier::raw;
+  }
+
+  // Aggregates of the tier for resolution with time points in
+  // [fromTimePoint, toTimePoint), oldest first, appended to result; the
+  // tier they came from is returned. The buckets still open are not in
+  // the aggregate tiers yet.
+  Tier query(
+    double fromTimePoint,
+    double toTimePoint,
+    double resolution,
+    std::vector<Aggregate>& result
+  ) const;
+
+ private:
+  using RawRing = SeqRing<2>;
+  using AggregateRing = SeqRing<5>;
+
+  // Open bucket of an aggregate tier.
+  struct Bucket {
+    double timePoint = std::numeric_limits<double>::quiet_NaN();
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double sum = 0;
+    uint64_t count = 0;
+
+    void add(const Bucket& other) {
+      min = std::min(min, other.min);
+      max = std::max(max, other.max);
+      sum += other.sum;
+      count += other.count;
+    }
+  };
+
+  void append(
+    const DataStream::BufferAsDouble& buffer,
+    double bufferTimePoint
+  );
+
+  // Adds sample to the bucket of resolution, pushing the bucket to ring
+  // when the sample is past it. Returns whether it did.
+  static bool aggregate(
+    const Bucket& sample,
+    double resolution,
+    Bucket& bucket,
+    AggregateRing& ring,
+    Bucket& closed
+  );
+
+  template<size_t WordsCount, typename F>
+  static void queryRing(
+    const SeqRing<WordsCount>& ring,
+    double fromTimePoint,
+    double toTimePoint,
+    F&& toAggregate,
+    std::vector<Aggregate>& result
+  );
+
+  DataStream& m_dataStream;
+
+  RawRing m_raw;
+  AggregateRing m_seconds;
+  AggregateRing m_minutes;
+
+  Bucket m_second;
+  Bucket m_minute;
+
+  boost::signals2::scoped_connection m_connection;
+};
+
+inline DataStreamStore::DataStreamStore(
+  DataStream& dataStream,
+  size_t rawCapacity,
+  size_t secondCapacity,
+  size_t minuteCapacity
+)
+    : m_dataStream(dataStream),
+      m_raw(rawCapacity),
+      m_seconds(secondCapacity),
+      m_minutes(minuteCapacity)
+{
+  m_connection = m_dataStream.emitAsDouble.connect(
+    [this](DataStream::ConstBufferAsDoubleSPtr bufferAsDoubleSPtr,
+           double bufferTimeMilliSecond) {
+      if(bufferAsDoubleSPtr) append(*bufferAsDoubleSPtr,
+                                    bufferTimeMilliSecond);
+    });
+  m_dataStream.demand.observerAdd();
+}
+
+inline void DataStreamStore::append(
+  const DataStream::BufferAsDouble& buffer,
+  double bufferTimePoint
+) {
+  RH_TRACE_SCOPE(buffer.size(), 0);
+  RH_PROFILE_ZONE;
+  const double samplingInterval = m_dataStream.samplingIntervalMilliSecond();
+  for(size_t i = 0; i < buffer.size(); ++i) {
+    const double timePoint = bufferTimePoint + i * samplingInterval;
+    const double value = buffer[i];
+    m_raw.push({bitCast<uint64_t>(timePoint), bitCast<uint64_t>(value)});
+
+    Bucket sample;
+    sample.timePoint = timePoint;
+    if(!std::isnan(value)) {
+      sample.min = sample.max = sample.sum = value;
+      sample.count = 1;
+    }
+    Bucket second;
+    if(aggregate(sample, secondResolution, m_second, m_seconds, second)) {
+      Bucket minute;
+      aggregate(second, minuteResolution, m_minute, m_minutes, minute);
+    }
+  }
+}
+
+inline bool DataStreamStore::aggregate(
+  const Bucket& sample,
+  double resolution,
+  Bucket& bucket,
+  AggregateRing& ring,
+  Bucket& closed
+) {
+  const double timePoint =
+    std::floor(sample.timePoint / resolution) * resolution;
+  bool pushed = false;
+  if(timePoint != bucket.timePoint) {
+    if(!std::isnan(bucket.timePoint)) {
+      const double mean = bucket.count == 0
+        ? std::numeric_limits<double>::quiet_NaN()
+        : bucket.sum / bucket.count;
+      ring.push({bitCast<uint64_t>(bucket.timePoint),
+                 bitCast<uint64_t>(bucket.min),
+                 bitCast<uint64_t>(bucket.max),
+                 bitCast<uint64_t>(mean),
+                 bucket.count});
+      closed = bucket;
+      pushed = true;
+    }
+    bucket = Bucket{};
+    bucket.timePoint = timePoint;
+  }
+  bucket.add(sample);
+  return pushed;
+}
+
+template<size_t WordsCount, typename F>
+inline void DataStreamStore::queryRing(
+  const SeqRing<WordsCount>& ring,
+  double fromTimePoint,
+  double toTimePoint,
+  F&& toAggregate,
+  std::vector<Aggregate>& result
+) {
+  typename SeqRing<WordsCount>::Record record;
+  const size_t resultFirst = result.size();
+  for(;;) {
+    const uint64_t written = ring.written();
+    uint64_t first = written > ring.capacity()
+      ? written - ring.capacity()
+      : 0;
+
+    // First record from fromTimePoint on.
+    uint64_t last = written;
+    while(first < last) {
+      const uint64_t middle = first + (last - first) / 2;
+      ring.read(middle, record);
+      if(bitCast<double>(record[0]) < fromTimePoint) first = middle + 1;
+      else last = middle;
+    }
+
+    for(uint64_t index = first; index < written; ++index) {
+      ring.read(index, record);
+      if(!(bitCast<double>(record[0]) < toTimePoint)) break;
+      result.push_back(toAggregate(record));
+    }
+
+    // Done unless the writer overwrote records read, and so maybe misled
+    // the search, meanwhile; then the reader lagged a whole ring behind
+    // and starts over from where the writer is now.
+    if(ring.validFrom() <= first) return;
+    result.resize(resultFirst);
+  }
+}
+
+inline DataStreamStore::Tier DataStreamStore::query(
+  double fromTimePoint,
+  double toTimePoint,
+  double resolution,
+  std::vector<Aggregate>& result
+) const {
+  RH_PROFILE_ZONE;
+  const Tier queried = tier(resolution);
+  if(queried == Tier::raw) {
+    queryRing(m_raw, fromTimePoint, toTimePoint,
+              [](const RawRing::Record& record) {
+                const double value = bitCast<double>(record[1]);
+                const bool isValue = !std::isnan(value);
+                return Aggregate{bitCast<double>(record[0]),
+                                 value, value, value,
+                                 isValue ? uint64_t(1) : uint64_t(0)};
+              }, result);
+  }
+  else {
+    queryRing(queried == Tier::second ? m_seconds : m_minutes,
+              fromTimePoint, toTimePoint,
+              [](const AggregateRing::Record& record) {
+                return Aggregate{bitCast<double>(record[0]),
+                                 bitCast<double>(record[1]),
+                                 bitCast<double>(record[2]),
+                                 bitCast<double>(record[3]),
+                                 record[4]};
+              }, result);
+  }
+  return queried;
+}
+
+} // namespace signal_processors
+
+} // namespace rh
+
+#endif // __DataStreamStore_hpp__
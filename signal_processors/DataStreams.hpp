@@ -2,8 +2,24 @@
 #ifndef __DataStreams_hpp__
 #define __DataStreams_hpp__
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <boost/signals2.hpp>
 
+#include "debug/RH_PROFILE.hpp"
+#include "debug/RH_TRACE.hpp"
+
+#include "BitCast.hpp"
+#include "Demand.hpp"
+
 namespace rh {
 
 namespace signal_processors {
@@ -19,38 +35,198 @@ class DataStream {
     double timePointMilliSecond;
   };
 
+  // Last value of a stream, published by one writer and read by any
+  // number of readers without locks: a seqlock. The writer makes the two
+  // stores of value and time point between two of the sequence number;
+  // readers retry when it changed meanwhile and never write to the
+  // cell, so they neither block the writer nor take its cache line. NaN
+  // value and time point until the first publish().
+  class alignas(64) LastValueCell {
+   public:
+    void publish(double value, double timePointMilliSecond) {
+      const uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+      m_sequence.store(sequence + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      m_value.store(bitCast<uint64_t>(value), std::memory_order_relaxed);
+      m_timePoint.store(bitCast<uint64_t>(timePointMilliSecond),
+                        std::memory_order_relaxed);
+      m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    DoubleTimed read() const {
+      for(;;) {
+        const uint64_t sequence = readBegin();
+        const DoubleTimed result = load();
+        if(readValid(sequence)) return result;
+        std::this_thread::yield();
+      }
+    }
+
+   private:
+    friend class DataStream;
+
+    uint64_t readBegin() const {
+      return m_sequence.load(std::memory_order_acquire);
+    }
+
+    DoubleTimed load() const {
+      return DoubleTimed(
+        bitCast<double>(m_value.load(std::memory_order_relaxed)),
+        bitCast<double>(m_timePoint.load(std::memory_order_relaxed)));
+    }
+
+    // Whether what load() returned since readBegin() returned sequence
+    // was published as a whole.
+    bool readValid(uint64_t sequence) const {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return readUnchanged(sequence);
+    }
+
+    // Same after an acquire fence of the caller's.
+    bool readUnchanged(uint64_t sequence) const {
+      return (sequence & 1) == 0 &&
+             m_sequence.load(std::memory_order_relaxed) == sequence;
+    }
+
+    std::atomic<uint64_t> m_sequence{0};
+    std::atomic<uint64_t> m_value{
+      bitCast<uint64_t>(std::numeric_limits<double>::quiet_NaN())};
+    std::atomic<uint64_t> m_timePoint{
+      bitCast<uint64_t>(std::numeric_limits<double>::quiet_NaN())};
+  };
+
   using BufferAsDouble = std::vector<double>;
   using ConstBufferAsDouble = const BufferAsDouble;
   using ConstBufferAsDoubleSPtr = std::shared_ptr<ConstBufferAsDouble>;
 
-  using EmitAsDoubleSignal =
-    boost::signals2::signal<void(ConstBufferAsDoubleSPtr bufferAsDoubleSPtr,
-                                 double bufferTimeMilliSecond)>;
+  // Emits inside an RH_TRACE_SCOPE of buffer size and slots count and an
+  // RH_PROFILE_ZONE.
+  class EmitAsDoubleSignal
+      : public boost::signals2::signal<
+          void(ConstBufferAsDoubleSPtr bufferAsDoubleSPtr,
+               double bufferTimeMilliSecond)>
+  {
+   public:
+    void operator()(ConstBufferAsDoubleSPtr bufferAsDoubleSPtr,
+                    double bufferTimeMilliSecond) {
+      RH_TRACE_SCOPE(bufferAsDoubleSPtr ? bufferAsDoubleSPtr->size() : 0,
+                     num_slots());
+      RH_PROFILE_ZONE;
+      signal::operator()(std::move(bufferAsDoubleSPtr),
+                         bufferTimeMilliSecond);
+    }
+  };
 
   EmitAsDoubleSignal emitAsDouble;
 
   using ActiveChangedSignal = boost::signals2::signal<void(bool active)>;
   ActiveChangedSignal activeChanged;
 
+  // Whether anybody consumes the stream: its last value observers, and
+  // the streams and stores consuming it that are demanded themselves.
+  DemandNode demand;
+
   virtual size_t samplesPerTransaction() =0;
   virtual double samplingIntervalMilliSecond() =0;
 
+  // The last value published by lastValuePublish(), unless a stream
+  // overrides them.
   virtual void lastValueAsDouble(
-    const std::function<void(DoubleTimed)>& callback) =0;
-  virtual DoubleTimed lastValueAsDouble() = 0;
+    const std::function<void(DoubleTimed)>& callback) {
+    callback(lastValueAsDouble());
+  }
+
+  virtual DoubleTimed lastValueAsDouble() {
+    return m_lastValueCell.read();
+  }
+
+  // Appends the last values of dataStreams to lastValues, in order, as
+  // lastValueAsDouble() returns them. Their cells are read in one pass,
+  // checked in another and only the ones published meanwhile are read
+  // again, so a UI snapshot of many streams costs little more than their
+  // loads. Streams that never called lastValuePublish(), e.g. overriding
+  // lastValueAsDouble(), are asked through lastValueAsDouble().
+  static void lastValuesAsDouble(
+    DataStream* const* dataStreams,
+    size_t dataStreamsCount,
+    std::vector<DoubleTimed>& lastValues
+  );
 
   using LastValueObserversCount = size_t;
 
-  virtual LastValueObserversCount lastValueObserversCount() =0;
-  virtual LastValueObserversCount lastValueObserverAdd() =0;
-  virtual LastValueObserversCount lastValueObserverRemove() =0;
+  virtual LastValueObserversCount lastValueObserversCount() {
+    return m_lastValueObserversCount.load(std::memory_order_relaxed);
+  }
+
+  // Observers of the last value also demand the stream.
+  virtual LastValueObserversCount lastValueObserverAdd() {
+    demand.observerAdd();
+    return m_lastValueObserversCount.fetch_add(
+      1, std::memory_order_relaxed) + 1;
+  }
+
+  // Never below zero.
+  virtual LastValueObserversCount lastValueObserverRemove() {
+    LastValueObserversCount count =
+      m_lastValueObserversCount.load(std::memory_order_relaxed);
+    while(count > 0 &&
+          !m_lastValueObserversCount.compare_exchange_weak(
+            count, count - 1, std::memory_order_relaxed)) {}
+    if(count == 0) return 0;
+    demand.observerRemove();
+    return count - 1;
+  }
 
   virtual bool active() =0;
   virtual void active(const std::function<void(bool)>& callback) =0;
 
   virtual std::string dataDescription() const =0;
+
+ protected:
+  // From the acquisition thread only.
+  void lastValuePublish(double value, double timePointMilliSecond) {
+    m_lastValueCell.publish(value, timePointMilliSecond);
+  }
+
+ private:
+  LastValueCell m_lastValueCell;
+  std::atomic<LastValueObserversCount> m_lastValueObserversCount{0};
 };
 
+inline void DataStream::lastValuesAsDouble(
+  DataStream* const* dataStreams,
+  size_t dataStreamsCount,
+  std::vector<DoubleTimed>& lastValues
+) {
+  RH_TRACE_SCOPE(dataStreamsCount, 0);
+  RH_PROFILE_ZONE;
+  constexpr size_t chunkCount = 64;
+  const size_t first = lastValues.size();
+  lastValues.reserve(first + dataStreamsCount);
+
+  for(size_t chunk = 0; chunk < dataStreamsCount; chunk += chunkCount) {
+    const size_t count = std::min(chunkCount, dataStreamsCount - chunk);
+    DataStream* const* chunkDataStreams = dataStreams + chunk;
+    uint64_t sequences[chunkCount];
+    for(size_t i = 0; i < count; ++i) {
+      const LastValueCell& cell = chunkDataStreams[i]->m_lastValueCell;
+      sequences[i] = cell.readBegin();
+      lastValues.push_back(cell.load());
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    for(size_t i = 0; i < count; ++i) {
+      const LastValueCell& cell = chunkDataStreams[i]->m_lastValueCell;
+      if(sequences[i] == 0) {
+        lastValues[first + chunk + i] =
+          chunkDataStreams[i]->lastValueAsDouble();
+      }
+      else if(!cell.readUnchanged(sequences[i])) {
+        lastValues[first + chunk + i] = cell.read();
+      }
+    }
+  }
+}
+
 } // namespace signal_processors
 
 } // namespace rh
@@ -0,0 +1,141 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+#ifndef __Demand_hpp__
+#define __Demand_hpp__
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "function/RH_FUNCTION.hpp"
+
+namespace rh {
+
+namespace signal_processors {
+
+// Whether anybody consumes a pipeline node's results: its observers, e.g.
+// UI views, and the demanded nodes consuming it. A node gaining demand
+// demands the nodes it consumes, losing it releases them, so unobserved
+// derived channels idle all the way upstream:
+//
+//   Derived(DataStream& source) {
+//     demand.consume(source.demand);
+//     m_connection = source.emitAsDouble.connect(...);
+//   }
+//
+//   void onBuffer(...) {
+//     switch(demand.poll()) {
+//       case DemandNode::Poll::idle: return;
+//       case DemandNode::Poll::resumed: m_averager = Averager(...); break;
+//       case DemandNode::Poll::running: break;
+//     }
+//     ...
+//   }
+//
+// poll() is the processing thread's view: resumed once at the first
+// buffer after demand came back, so processors restart there as
+// constructed and their windows warm up from that buffer on; demand
+// dropped and back between two buffers skipped none, so it is running.
+//
+// Demand changes on any thread; nodes consumed outlive their consumers
+// and consume no node consuming them.
+class DemandNode {
+ public:
+  enum class Poll {idle, resumed, running};
+
+  using DemandChangedCallback = RH_InplaceFunction<void(bool demanded)>;
+
+  DemandNode() =default;
+
+  DemandNode(const DemandNode&) = delete;
+  DemandNode& operator=(const DemandNode&) = delete;
+
+  ~DemandNode() {
+    std::vector<DemandNode*> upstreams;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      upstreams.swap(m_upstreams);
+      if(m_demand.load(std::memory_order_relaxed) == 0) return;
+    }
+    for(DemandNode* upstream : upstreams) upstream->demandRemove();
+  }
+
+  // Called with demanded() changed, under this node's lock, e.g. for a
+  // source to start or stop acquisition. It must not change the demand
+  // of this node or of the nodes consuming it.
+  void demandChanged(DemandChangedCallback callback) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_demandChanged = std::move(callback);
+  }
+
+  void consume(DemandNode& upstream) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_upstreams.push_back(&upstream);
+    if(m_demand.load(std::memory_order_relaxed) > 0) upstream.demandAdd();
+  }
+
+  void unconsume(DemandNode& upstream) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = std::find(m_upstreams.begin(), m_upstreams.end(),
+                           &upstream);
+    if(found == m_upstreams.end()) return;
+    m_upstreams.erase(found);
+    if(m_demand.load(std::memory_order_relaxed) > 0) {
+      upstream.demandRemove();
+    }
+  }
+
+  void observerAdd() {
+    demandAdd();
+  }
+
+  // Of an observer added before.
+  void observerRemove() {
+    demandRemove();
+  }
+
+  bool demanded() const {
+    return m_demand.load(std::memory_order_acquire) > 0;
+  }
+
+  // From the processing thread only, once per buffer.
+  Poll poll() {
+    const bool demanded = this->demanded();
+    const bool wasDemanded = m_polledDemanded;
+    m_polledDemanded = demanded;
+    if(!demanded) return Poll::idle;
+    return wasDemanded ? Poll::running : Poll::resumed;
+  }
+
+ private:
+  void demandAdd() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_demand.fetch_add(1, std::memory_order_acq_rel) > 0) return;
+    for(DemandNode* upstream : m_upstreams) upstream->demandAdd();
+    if(m_demandChanged) m_demandChanged(true);
+  }
+
+  void demandRemove() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_demand.fetch_sub(1, std::memory_order_acq_rel) > 1) return;
+    for(DemandNode* upstream : m_upstreams) upstream->demandRemove();
+    if(m_demandChanged) m_demandChanged(false);
+  }
+
+  // Locked downstream first, so consuming no consumer keeps it deadlock
+  // free.
+  std::mutex m_mutex;
+  std::atomic<size_t> m_demand{0};
+  std::vector<DemandNode*> m_upstreams;
+  DemandChangedCallback m_demandChanged;
+
+  // Of the processing thread.
+  bool m_polledDemanded = false;
+};
+
+} // namespace signal_processors
+
+} // namespace rh
+
+#endif // __Demand_hpp__
@@ -0,0 +1,267 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+#ifndef __RangeIndex_hpp__
+#define __RangeIndex_hpp__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "debug/RH_PROFILE.hpp"
+#include "debug/RH_TRACE.hpp"
+#include "reflection/RH_FIELDS.hpp"
+#include "reflection/RH_FIELDS_BINARY.hpp"
+
+namespace rh {
+
+namespace signal_processors {
+
+// Min, max, sum and count of samples, NaN ones left out.
+template<typename V>
+struct RangeAggregate {
+  using Value = V;
+
+  static constexpr Value noMin = std::numeric_limits<Value>::has_infinity
+    ? std::numeric_limits<Value>::infinity()
+    : std::numeric_limits<Value>::max();
+  static constexpr Value noMax = std::numeric_limits<Value>::has_infinity
+    ? -std::numeric_limits<Value>::infinity()
+    : std::numeric_limits<Value>::lowest();
+
+  Value min = noMin;
+  Value max = noMax;
+  double sum = 0;
+  uint64_t count = 0;
+
+  // NaN when there are no samples.
+  double mean() const {
+    return count == 0
+      ? std::numeric_limits<double>::quiet_NaN()
+      : sum / count;
+  }
+
+  void add(const RangeAggregate& other) {
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    sum += other.sum;
+    count += other.count;
+  }
+
+  // Comparisons are false for NaN, so NaN samples leave min and max be.
+  void add(const Value* values, size_t samplesCount) {
+    for(size_t i = 0; i < samplesCount; ++i) {
+      const Value value = values[i];
+      min = value < min ? value : min;
+      max = value > max ? value : max;
+      if constexpr(std::is_floating_point_v<Value>) {
+        const bool isValue = value == value;
+        sum += isValue ? double(value) : 0.0;
+        count += isValue;
+      }
+      else sum += value;
+    }
+    if constexpr(!std::is_floating_point_v<Value>) count += samplesCount;
+  }
+
+  // Written field by field, so snapshots carry no padding bytes.
+  RH_FIELDS(RangeAggregate, min, max, sum, count)
+};
+
+// Index of min/max/sum/count over the samples of a recording, built as
+// they are appended: aggregates of blocks of blockSamplesCount samples
+// are the leaves of a segment tree, whose level k holds aggregates of
+// 2^k blocks. A range query takes the tree nodes covering its whole
+// blocks, O(log n), and scans the samples of the partial blocks at its
+// ends, so it is given the recorded samples it was built over:
+//
+//   index.append(buffer.data(), buffer.size());
+//   recording.insert(recording.end(), buffer.begin(), buffer.end());
+//   ...
+//   auto aggregate = index.query(recording.data(), first, last);
+//
+// The index keeps about two aggregates per block. It is an RH_FIELDS
+// class, so RH_BinaryWriter saves it next to the recording and read()
+// loads it back.
+template<typename V>
+class RangeIndex {
+ public:
+  using Value = V;
+  using Aggregate = RangeAggregate<Value>;
+
+  explicit RangeIndex(size_t blockSamplesCount = 256)
+      : m_blockSamplesCount{blockSamplesCount}
+  {
+    if(m_blockSamplesCount == 0) {
+      throw std::invalid_argument("RangeIndex: zero block samples count");
+    }
+  }
+
+  // Of a snapshot written by RH_BinaryWriter. Throws std::runtime_error
+  // as RH_BinaryReader does, or when the snapshot is no index of
+  // samplesCount() samples, leaving this index as it was.
+  void read(RH_BinaryReader& reader);
+
+  void append(const Value* values, size_t samplesCount);
+
+  size_t samplesCount() const {
+    return m_samplesCount;
+  }
+
+  size_t blockSamplesCount() const {
+    return m_blockSamplesCount;
+  }
+
+  // Aggregate of samples [firstIndex, lastIndex) of values, the samples
+  // appended so far.
+  Aggregate query(
+    const Value* values,
+    size_t firstIndex,
+    size_t lastIndex
+  ) const;
+
+  // Aggregate of the samples with time points in [fromTimePoint,
+  // toTimePoint), time points being ascending.
+  template<typename T>
+  Aggregate query(
+    const Value* values,
+    const T* timePoints,
+    T fromTimePoint,
+    T toTimePoint
+  ) const;
+
+ private:
+  // Block aggregate to m_levels[0] and its ancestors up.
+  void pushBlock(const Aggregate& aggregate);
+
+  // Whether the levels are those append() builds.
+  bool isValid() const;
+
+  size_t m_blockSamplesCount;
+  size_t m_samplesCount = 0;
+
+  // Of the samples past the last whole block.
+  Aggregate m_open;
+
+  // m_levels[k][i] aggregates nodes 2i and 2i + 1 of level k - 1, or
+  // only 2i when it is the last.
+  std::vector<std::vector<Aggregate>> m_levels;
+
+ public:
+  RH_FIELDS(RangeIndex, m_blockSamplesCount, m_samplesCount, m_open,
+            m_levels)
+};
+
+template<typename V>
+inline void RangeIndex<V>::append(const Value* values, size_t samplesCount) {
+  RH_TRACE_SCOPE(samplesCount, 0);
+  RH_PROFILE_ZONE;
+  while(samplesCount > 0) {
+    const size_t openCount = m_samplesCount % m_blockSamplesCount;
+    const size_t count =
+      std::min(samplesCount, m_blockSamplesCount - openCount);
+    m_open.add(values, count);
+    values += count;
+    samplesCount -= count;
+    m_samplesCount += count;
+    if(openCount + count == m_blockSamplesCount) {
+      pushBlock(m_open);
+      m_open = Aggregate{};
+    }
+  }
+}
+
+template<typename V>
+inline void RangeIndex<V>::read(RH_BinaryReader& reader) {
+  RangeIndex index;
+  reader.read(index);
+  if(!index.isValid()) throw std::runtime_error("RangeIndex: invalid data");
+  *this = std::move(index);
+}
+
+template<typename V>
+inline bool RangeIndex<V>::isValid() const {
+  if(m_blockSamplesCount == 0) return false;
+  size_t nodesCount = m_samplesCount / m_blockSamplesCount;
+  if(nodesCount == 0) return m_levels.empty();
+  for(size_t k = 0; k < m_levels.size(); ++k) {
+    if(m_levels[k].size() != nodesCount) return false;
+    if(nodesCount == 1) return k + 1 == m_levels.size();
+    nodesCount = (nodesCount + 1) / 2;
+  }
+  return false;
+}
+
+template<typename V>
+inline void RangeIndex<V>::pushBlock(const Aggregate& aggregate) {
+  if(m_levels.empty()) m_levels.emplace_back();
+  m_levels[0].push_back(aggregate);
+  size_t index = m_levels[0].size() - 1;
+  for(size_t k = 1; m_levels[k - 1].size() > 1; ++k) {
+    if(m_levels.size() == k) m_levels.emplace_back();
+    const std::vector<Aggregate>& children = m_levels[k - 1];
+    const size_t child = index & ~size_t(1);
+    Aggregate node = children[child];
+    if(child + 1 < children.size()) node.add(children[child + 1]);
+    index /= 2;
+    if(index < m_levels[k].size()) m_levels[k][index] = node;
+    else m_levels[k].push_back(node);
+  }
+}
+
+template<typename V>
+inline typename RangeIndex<V>::Aggregate RangeIndex<V>::query(
+  const Value* values,
+  size_t firstIndex,
+  size_t lastIndex
+) const {
+  RH_PROFILE_ZONE;
+  Aggregate result;
+  lastIndex = std::min(lastIndex, m_samplesCount);
+  if(firstIndex >= lastIndex) return result;
+
+  // Whole blocks in the range, partial ones at its ends.
+  size_t firstBlock =
+    (firstIndex + m_blockSamplesCount - 1) / m_blockSamplesCount;
+  size_t lastBlock = lastIndex / m_blockSamplesCount;
+  if(firstBlock >= lastBlock) {
+    result.add(values + firstIndex, lastIndex - firstIndex);
+    return result;
+  }
+  result.add(values + firstIndex,
+             firstBlock * m_blockSamplesCount - firstIndex);
+  result.add(values + lastBlock * m_blockSamplesCount,
+             lastIndex - lastBlock * m_blockSamplesCount);
+
+  for(size_t k = 0; firstBlock < lastBlock; ++k) {
+    const std::vector<Aggregate>& level = m_levels[k];
+    if(firstBlock & 1) result.add(level[firstBlock++]);
+    if(lastBlock & 1) result.add(level[--lastBlock]);
+    firstBlock /= 2;
+    lastBlock /= 2;
+  }
+  return result;
+}
+
+template<typename V>
+template<typename T>
+inline typename RangeIndex<V>::Aggregate RangeIndex<V>::query(
+  const Value* values,
+  const T* timePoints,
+  T fromTimePoint,
+  T toTimePoint
+) const {
+  const T* end = timePoints + m_samplesCount;
+  const T* first = std::lower_bound(timePoints, end, fromTimePoint);
+  const T* last = std::lower_bound(first, end, toTimePoint);
+  return query(values, first - timePoints, last - timePoints);
+}
+
+} // namespace signal_processors
+
+} // namespace rh
+
+#endif // __RangeIndex_hpp__
@@ -0,0 +1,469 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+#ifndef __SharedMemoryTransport_hpp__
+#define __SharedMemoryTransport_hpp__
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <boost/signals2.hpp>
+
+#include "debug/RH_PROFILE.hpp"
+#include "debug/RH_TRACE.hpp"
+
+#include "BitCast.hpp"
+#include "DataStreams.hpp"
+
+namespace rh {
+
+namespace signal_processors {
+
+// Transport of a DataStream's transactions to other processes of the
+// host, through a POSIX shared memory segment of a ring of samples and a
+// ring of transaction descriptors:
+//
+//   publisher   SharedMemoryPublisher publisher(dataStream, "/adc0");
+//   subscriber  SharedMemorySubscriber subscriber("/adc0");
+//               subscriber.read([](const double* samples, size_t count,
+//                                  double bufferTimeMilliSecond) {...},
+//                               std::chrono::milliseconds(100));
+//
+// The publisher copies each emitAsDouble buffer into the ring once and
+// never waits for subscribers: they read in place from their own cursor
+// and sleep on a futex, which the publisher wakes only when some wait. A
+// subscriber the publisher laps gets an overrun and continues from the
+// newest transaction. Linux only, as futexes are.
+class SharedMemoryRing {
+ public:
+  static constexpr uint64_t magic = 0x52485348524d5247ull;
+  static constexpr uint32_t version = 1;
+
+  struct Header {
+    uint64_t magic;
+    uint32_t version;
+    uint64_t samplesCapacity;
+    uint64_t transactionsCapacity;
+    std::atomic<uint64_t> samplingIntervalMilliSecond;
+
+    // Of the publisher.
+    alignas(64) std::atomic<uint64_t> published;
+    std::atomic<uint64_t> samplesBegun;
+    std::atomic<uint32_t> futexWord;
+
+    // Of the subscribers.
+    alignas(64) std::atomic<uint32_t> waitersCount;
+  };
+
+  // Valid while index is the transaction's index + 1.
+  struct Descriptor {
+    std::atomic<uint64_t> index;
+    std::atomic<uint64_t> samplesPosition;
+    std::atomic<uint64_t> samplesCount;
+    std::atomic<uint64_t> bufferTimeMilliSecond;
+  };
+
+  static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                std::atomic<uint32_t>::is_always_lock_free,
+                "shared memory atomics must be lock free");
+
+  static size_t bytes(uint64_t samplesCapacity,
+                      uint64_t transactionsCapacity) {
+    return samplesOffset(transactionsCapacity) +
+      samplesCapacity * sizeof(double);
+  }
+
+  // Maps the segment of name, created with the layout given or opened
+  // with the one it has.
+  SharedMemoryRing(
+    const std::string& name,
+    uint64_t samplesCapacity,
+    uint64_t transactionsCapacity
+  );
+
+  explicit SharedMemoryRing(const std::string& name);
+
+  ~SharedMemoryRing();
+
+  SharedMemoryRing(const SharedMemoryRing&) = delete;
+  SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+
+  Header& header() const {
+    return *static_cast<Header*>(m_address);
+  }
+
+  Descriptor& descriptor(uint64_t index) const {
+    return reinterpret_cast<Descriptor*>(
+      static_cast<char*>(m_address) + sizeof(Header))[
+        index % header().transactionsCapacity];
+  }
+
+  double* samples(uint64_t position) const {
+    return reinterpret_cast<double*>(
+      static_cast<char*>(m_address) +
+      samplesOffset(header().transactionsCapacity)) +
+      position % header().samplesCapacity;
+  }
+
+  // futex(2) on a word shared between processes.
+  static void futexWake(std::atomic<uint32_t>& word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE,
+            INT_MAX, nullptr, nullptr, 0);
+  }
+
+  static void futexWait(
+    std::atomic<uint32_t>& word,
+    uint32_t value,
+    std::chrono::nanoseconds timeout
+  ) {
+    const auto seconds =
+      std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    const timespec relativeTimeout{
+      static_cast<time_t>(seconds.count()),
+      static_cast<long>((timeout - seconds).count())};
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT,
+            value, &relativeTimeout, nullptr, 0);
+  }
+
+ private:
+  static size_t samplesOffset(uint64_t transactionsCapacity) {
+    const size_t offset =
+      sizeof(Header) + transactionsCapacity * sizeof(Descriptor);
+    return (offset + 63) / 64 * 64;
+  }
+
+  void map(int fileDescriptor, size_t bytes, const std::string& name);
+
+  std::string m_name;
+  bool m_owner = false;
+  void* m_address = nullptr;
+  size_t m_bytes = 0;
+};
+
+inline SharedMemoryRing::SharedMemoryRing(
+  const std::string& name,
+  uint64_t samplesCapacity,
+  uint64_t transactionsCapacity
+)
+    : m_name(name),
+      m_owner(true)
+{
+  if(samplesCapacity == 0 || transactionsCapacity == 0) {
+    throw std::invalid_argument("SharedMemoryRing: zero capacity");
+  }
+  // A segment left by a publisher that did not exit cleanly goes; its
+  // subscribers keep their mapping of it.
+  shm_unlink(name.c_str());
+  const int fileDescriptor =
+    shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if(fileDescriptor < 0) {
+    throw std::system_error(errno, std::generic_category(),
+                            "shm_open " + name);
+  }
+  const size_t bytes = this->bytes(samplesCapacity, transactionsCapacity);
+  if(ftruncate(fileDescriptor, bytes) != 0) {
+    const int error = errno;
+    close(fileDescriptor);
+    shm_unlink(name.c_str());
+    throw std::system_error(error, std::generic_category(),
+                            "ftruncate " + name);
+  }
+  map(fileDescriptor, bytes, name);
+
+  // The segment is zero filled, so are the descriptors.
+  Header& header = *new(m_address) Header{};
+  header.samplesCapacity = samplesCapacity;
+  header.transactionsCapacity = transactionsCapacity;
+  header.version = version;
+  std::atomic_thread_fence(std::memory_order_release);
+  header.magic = magic;
+}
+
+inline SharedMemoryRing::SharedMemoryRing(const std::string& name)
+    : m_name(name)
+{
+  const int fileDescriptor = shm_open(name.c_str(), O_RDWR, 0);
+  if(fileDescriptor < 0) {
+    throw std::system_error(errno, std::generic_category(),
+                            "shm_open " + name);
+  }
+  struct stat status;
+  if(fstat(fileDescriptor, &status) != 0 ||
+     size_t(status.st_size) < sizeof(Header)) {
+    close(fileDescriptor);
+    throw std::runtime_error("SharedMemoryRing: no ring in " + name);
+  }
+  map(fileDescriptor, status.st_size, name);
+  const Header& header = this->header();
+  // Capacities bounded first, so that bytes() cannot overflow.
+  if(header.magic != magic || header.version != version ||
+     header.samplesCapacity == 0 || header.transactionsCapacity == 0 ||
+     header.samplesCapacity > m_bytes / sizeof(double) ||
+     header.transactionsCapacity > m_bytes / sizeof(Descriptor) ||
+     bytes(header.samplesCapacity, header.transactionsCapacity) >
+     m_bytes) {
+    munmap(m_address, m_bytes);
+    throw std::runtime_error("SharedMemoryRing: no ring in " + name);
+  }
+}
+
+inline SharedMemoryRing::~SharedMemoryRing() {
+  munmap(m_address, m_bytes);
+  if(m_owner) shm_unlink(m_name.c_str());
+}
+
+inline void SharedMemoryRing::map(
+  int fileDescriptor,
+  size_t bytes,
+  const std::string& name
+) {
+  m_address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                   fileDescriptor, 0);
+  const int error = errno;
+  close(fileDescriptor);
+  if(m_address == MAP_FAILED) {
+    if(m_owner) shm_unlink(name.c_str());
+    throw std::system_error(error, std::generic_category(), "mmap " + name);
+  }
+  m_bytes = bytes;
+}
+
+// Writer of a DataStream's transactions to a SharedMemoryRing. A
+// transaction is kept whole in the samples ring, so one larger than it
+// is dropped and counted. The publisher observes the stream's demand
+// while it exists.
+class SharedMemoryPublisher {
+ public:
+  SharedMemoryPublisher(
+    DataStream& dataStream,
+    const std::string& name,
+    uint64_t samplesCapacity = uint64_t(1) << 20,
+    uint64_t transactionsCapacity = 4096
+  );
+
+  ~SharedMemoryPublisher() {
+    m_dataStream.demand.observerRemove();
+  }
+
+  SharedMemoryPublisher(const SharedMemoryPublisher&) = delete;
+  SharedMemoryPublisher& operator=(const SharedMemoryPublisher&) = delete;
+
+  uint64_t publishedCount() const {
+    return m_published;
+  }
+
+  uint64_t droppedCount() const {
+    return m_dropped;
+  }
+
+  // From the stream's thread only.
+  void publish(
+    const double* samples,
+    size_t samplesCount,
+    double bufferTimeMilliSecond
+  );
+
+ private:
+  DataStream& m_dataStream;
+  SharedMemoryRing m_ring;
+
+  uint64_t m_published = 0;
+  uint64_t m_dropped = 0;
+  uint64_t m_samplesPosition = 0;
+
+  boost::signals2::scoped_connection m_connection;
+};
+
+inline SharedMemoryPublisher::SharedMemoryPublisher(
+  DataStream& dataStream,
+  const std::string& name,
+  uint64_t samplesCapacity,
+  uint64_t transactionsCapacity
+)
+    : m_dataStream(dataStream),
+      m_ring(name, samplesCapacity, transactionsCapacity)
+{
+  m_connection = m_dataStream.emitAsDouble.connect(
+    [this](DataStream::ConstBufferAsDoubleSPtr bufferAsDoubleSPtr,
+           double bufferTimeMilliSecond) {
+      if(bufferAsDoubleSPtr) {
+        publish(bufferAsDoubleSPtr->data(), bufferAsDoubleSPtr->size(),
+                bufferTimeMilliSecond);
+      }
+    });
+  m_dataStream.demand.observerAdd();
+}
+
+inline void SharedMemoryPublisher::publish(
+  const double* samples,
+  size_t samplesCount,
+  double bufferTimeMilliSecond
+) {
+  RH_TRACE_SCOPE(samplesCount, m_published);
+  RH_PROFILE_ZONE;
+  SharedMemoryRing::Header& header = m_ring.header();
+  const uint64_t capacity = header.samplesCapacity;
+  if(samplesCount > capacity) {
+    ++m_dropped;
+    return;
+  }
+
+  // Whole in the ring, from its start when it would wrap. Subscribers
+  // tell overwritten samples by samplesBegun, published before them.
+  uint64_t position = m_samplesPosition;
+  if(position % capacity + samplesCount > capacity) {
+    position += capacity - position % capacity;
+  }
+  header.samplesBegun.store(position + samplesCount,
+                            std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(m_ring.samples(position), samples,
+              samplesCount * sizeof(double));
+  m_samplesPosition = position + samplesCount;
+
+  SharedMemoryRing::Descriptor& descriptor = m_ring.descriptor(m_published);
+  descriptor.index.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  descriptor.samplesPosition.store(position, std::memory_order_relaxed);
+  descriptor.samplesCount.store(samplesCount, std::memory_order_relaxed);
+  descriptor.bufferTimeMilliSecond.store(
+    bitCast<uint64_t>(bufferTimeMilliSecond),
+    std::memory_order_relaxed);
+  descriptor.index.store(m_published + 1, std::memory_order_release);
+
+  ++m_published;
+  header.samplingIntervalMilliSecond.store(
+    bitCast<uint64_t>(m_dataStream.samplingIntervalMilliSecond()),
+    std::memory_order_relaxed);
+  header.published.store(m_published, std::memory_order_release);
+
+  // Sequentially consistent with the waiters' count and futex word
+  // accesses of the subscribers, so that none sleeps through it.
+  header.futexWord.store(uint32_t(m_published));
+  if(header.waitersCount.load() > 0) {
+    SharedMemoryRing::futexWake(header.futexWord);
+  }
+}
+
+// Reader of a SharedMemoryRing, from the transaction published after it
+// mapped it on.
+class SharedMemorySubscriber {
+ public:
+  enum class Status {read, timeout, overrun};
+
+  explicit SharedMemorySubscriber(const std::string& name)
+      : m_ring(name),
+        m_cursor{m_ring.header().published.load(std::memory_order_acquire)}
+  {}
+
+  // Waits up to timeout for the next transaction and calls
+  // f(const double* samples, size_t count, double bufferTimeMilliSecond)
+  // with it in place in the ring. overrun when the publisher overwrote
+  // the transaction before or while f read it, when what f made of it is
+  // to be dropped; the next read is of the newest transaction then.
+  template<typename F>
+  Status read(F&& f, std::chrono::nanoseconds timeout);
+
+  // Transactions skipped by overruns.
+  uint64_t lostCount() const {
+    return m_lost;
+  }
+
+  double samplingIntervalMilliSecond() const {
+    return bitCast<double>(
+      m_ring.header().samplingIntervalMilliSecond.load(
+        std::memory_order_relaxed));
+  }
+
+ private:
+  // Whether samples from position on were not overwritten yet.
+  bool samplesValid(uint64_t position) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const SharedMemoryRing::Header& header = m_ring.header();
+    return header.samplesBegun.load(std::memory_order_relaxed) <=
+           position + header.samplesCapacity;
+  }
+
+  Status overrun(uint64_t published) {
+    const uint64_t newest = std::max(published, m_cursor + 1) - 1;
+    m_lost += newest - m_cursor;
+    m_cursor = newest;
+    return Status::overrun;
+  }
+
+  SharedMemoryRing m_ring;
+  uint64_t m_cursor;
+  uint64_t m_lost = 0;
+};
+
+template<typename F>
+inline SharedMemorySubscriber::Status SharedMemorySubscriber::read(
+  F&& f,
+  std::chrono::nanoseconds timeout
+) {
+  RH_PROFILE_ZONE;
+  SharedMemoryRing::Header& header = m_ring.header();
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  uint64_t published = header.published.load(std::memory_order_acquire);
+  while(m_cursor >= published) {
+    const auto remaining = deadline - std::chrono::steady_clock::now();
+    if(remaining <= remaining.zero()) return Status::timeout;
+    header.waitersCount.fetch_add(1);
+    const uint32_t futexWord = header.futexWord.load();
+    published = header.published.load(std::memory_order_acquire);
+    if(m_cursor >= published) {
+      SharedMemoryRing::futexWait(header.futexWord, futexWord, remaining);
+      published = header.published.load(std::memory_order_acquire);
+    }
+    header.waitersCount.fetch_sub(1);
+  }
+  if(published - m_cursor > header.transactionsCapacity) {
+    return overrun(published);
+  }
+
+  const SharedMemoryRing::Descriptor& descriptor =
+    m_ring.descriptor(m_cursor);
+  const uint64_t index = descriptor.index.load(std::memory_order_acquire);
+  const uint64_t position =
+    descriptor.samplesPosition.load(std::memory_order_relaxed);
+  const uint64_t samplesCount =
+    descriptor.samplesCount.load(std::memory_order_relaxed);
+  const double bufferTimeMilliSecond = bitCast<double>(
+    descriptor.bufferTimeMilliSecond.load(std::memory_order_relaxed));
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if(index != m_cursor + 1 ||
+     descriptor.index.load(std::memory_order_relaxed) != index ||
+     !samplesValid(position)) {
+    return overrun(header.published.load(std::memory_order_acquire));
+  }
+
+  RH_TRACE_SCOPE(samplesCount, m_cursor);
+  f(static_cast<const double*>(m_ring.samples(position)),
+    static_cast<size_t>(samplesCount), bufferTimeMilliSecond);
+  if(!samplesValid(position)) {
+    return overrun(header.published.load(std::memory_order_acquire));
+  }
+  ++m_cursor;
+  return Status::read;
+}
+
+} // namespace signal_processors
+
+} // namespace rh
+
+#endif // __SharedMemoryTransport_hpp__
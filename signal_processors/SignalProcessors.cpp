@@ -0,0 +1,16 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+
+#include "SignalProcessors.hpp"
+
+namespace rh {
+
+namespace signal_processors {
+
+RH__SIGNAL_PROCESSORS_INSTANTIATE(, double)
+RH__SIGNAL_PROCESSORS_INSTANTIATE(, float)
+RH__SIGNAL_PROCESSORS_INSTANTIATE(, int32_t)
+RH__SIGNAL_PROCESSORS_INSTANTIATE(, int16_t)
+
+} // namespace signal_processors
+
+} // namespace rh
@@ -2,58 +2,31 @@
 #ifndef __SignalProcessors_hpp__
 #define __SignalProcessors_hpp__
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <limits>
 #include <vector>
 #include <cmath>
 #include <memory>
-#include <functional>
+#include <stdexcept>
 
-// TODO: * Convert all processors to MilliSecond (to do that convert scope
-//         processing to MilliSecond from Second).
+#include "debug/RH_PROFILE.hpp"
+#include "debug/RH_TRACE.hpp"
+#include "function/RH_FUNCTION.hpp"
+#include "inline/RH_INLINE.hpp"
+
+#include "TimeUnits.hpp"
 
 namespace rh {
 
 namespace signal_processors {
 
-class Second {};
-
-class MilliSecond {
- private:
-  using Self = MilliSecond;
-
- public:
-  using Value = double;
-
-  MilliSecond() =default;
-
-  MilliSecond(const Self& other)
-      : m_value{other.m_value}
-  {}
-
-  explicit MilliSecond(Value value)
-      : m_value{value}
-  {}
-
-  Value value() const {
-    return m_value;
-  }
-
-  Value& operator *() {
-    return m_value;
-  }
-
-  const Value& operator *() const {
-    return m_value;
-  }
-
- private:
-  Value m_value{};
-};
-
-template<typename V>
+template<typename V, typename T = double>
 class Buffered {
  public:
   using Value = V;
+  using TimePoint = T;
   using Buffer = std::vector<Value>;
   using BufferSPtr = std::shared_ptr<Buffer>;
 
@@ -83,32 +56,44 @@ class Buffered {
 
   void bufferReset() {
     m_buffer.clear();
-    m_bufferTimePoint = 0;
+    m_bufferTimePoint = TimePoint{};
   }
 
-  void bufferTimePoint(double value) {
+  void bufferTimePoint(TimePoint value) {
     m_bufferTimePoint = value;
   }
 
-  double bufferTimePoint() const {
+  TimePoint bufferTimePoint() const {
     return m_bufferTimePoint;
   }
 
  private:
   Buffer m_buffer;
-  double m_bufferTimePoint;
+  TimePoint m_bufferTimePoint;
   size_t m_samplesToBuffer;
 };
 
+template<typename TU = void>
 class ForceUpdated {
  public:
-  ForceUpdated(double forceUpdateTimeInterval)
+  using TimePoint = TimePointOf<TU>;
+  using Duration = DurationOf<TU>;
+
+  ForceUpdated(Duration forceUpdateTimeInterval)
       : m_forceUpdateTimeInterval(forceUpdateTimeInterval)
   {}
 
+  // Time point from which the next forced update is due; for a
+  // TimingWheel timer.
+  template<typename U = TU>
+  TimePointOf<U> expiryTimePoint() const {
+    return timePointCast<U, TU>(
+      m_lastUpdateTimePoint + m_forceUpdateTimeInterval);
+  }
+
  protected:
-  bool forceUpdate(double timePoint) {
-    double timeDuration = std::abs(timePoint - m_lastUpdateTimePoint);
+  bool forceUpdate(TimePoint timePoint) {
+    Duration timeDuration = timeDistance(timePoint, m_lastUpdateTimePoint);
     if(timeDuration >= m_forceUpdateTimeInterval) {
       m_lastUpdateTimePoint = timePoint;
       return true;
@@ -116,15 +101,30 @@ class ForceUpdated {
     else return false;
   }
 
+  // Whether forceUpdate() may return true for any of timePoints.
+  bool forceUpdatePossible(
+    const TimePoint* timePoints,
+    size_t timePointsCount
+  ) const {
+    // Selects, not a bool reduction, so that the compiler vectorizes it.
+    Duration possible{0};
+    for(size_t i = 0; i < timePointsCount; ++i) {
+      possible = timeDistance(timePoints[i], m_lastUpdateTimePoint) >=
+                 m_forceUpdateTimeInterval ? Duration{1} : possible;
+    }
+    return possible != Duration{0};
+  }
+
  private:
-  const double m_forceUpdateTimeInterval;
-  double m_lastUpdateTimePoint{0};
+  const Duration m_forceUpdateTimeInterval;
+  TimePoint m_lastUpdateTimePoint{};
 };
 
-template<typename V>
+template<typename V, typename T = double>
 class ChangeTrackerUnitlessBase {
  public:
   using Value = V;
+  using TimePoint = T;
 
   Value lastValue() {
     return m_lastValue;
@@ -139,70 +139,41 @@ class ChangeTrackerUnitlessBase {
     m_lastValue = value;
   }
 
-  double lastValueTimePoint() {
+  TimePoint lastValueTimePoint() {
     return m_lastValueTimePoint;
   }
 
-  void lastValueTimePoint(double value) {
+  void lastValueTimePoint(TimePoint value) {
     m_lastValueTimePoint = value;
   }
 
  private:
   Value m_lastValue;
-  double m_lastValueTimePoint;
+  TimePoint m_lastValueTimePoint{};
 };
 
 template<typename V, typename TU>
-class ChangeTrackerBase;
-
-template<typename V>
-class ChangeTrackerBase<V, void> : public ChangeTrackerUnitlessBase<V> {
+class ChangeTrackerBase : public ChangeTrackerUnitlessBase<V, TimePointOf<TU>> {
  private:
-  using Base = ChangeTrackerUnitlessBase<V>;
+  using Base = ChangeTrackerUnitlessBase<V, TimePointOf<TU>>;
 
  public:
   using Value = typename Base::Value;
+  using TimePoint = typename Base::TimePoint;
 
- protected:
-  ChangeTrackerBase(Value initialValue)
-      : Base(initialValue)
-  {}
-};
-
-template<typename V>
-class ChangeTrackerBase<V, Second> : public ChangeTrackerUnitlessBase<V> {
- private:
-  using Base = ChangeTrackerUnitlessBase<V>;
-
- public:
-  using Value = typename Base::Value;
-
-  double lastValueTimePointSecond() {
-    return Base::lastValueTimePoint;
+  template<typename U = TU>
+  TimePointOf<U> lastValueTimePoint() {
+    return timePointCast<U, TU>(Base::lastValueTimePoint());
   }
 
  protected:
   ChangeTrackerBase(Value initialValue)
       : Base(initialValue)
   {}
-};
 
-template<typename V>
-class ChangeTrackerBase<V, MilliSecond> : public ChangeTrackerUnitlessBase<V> {
- private:
-  using Base = ChangeTrackerUnitlessBase<V>;
-
- public:
-  using Value = typename Base::Value;
-
-  double lastValueTimePointMilliSecond() {
-    return Base::lastValueTimePoint;
+  void lastValueTimePoint(TimePoint value) {
+    Base::lastValueTimePoint(value);
   }
-
- protected:
-  ChangeTrackerBase(Value initialValue)
-      : Base(initialValue)
-  {}
 };
 
 template<typename V, typename TU>
@@ -212,10 +183,33 @@ class ChangeTracker : public ChangeTrackerBase<V, TU> {
 
  public:
   using Value = typename Base::Value;
+  using TimePoint = typename Base::TimePoint;
 
-  using ResultCallback = std::function<
-    void(Value lastValue, double lastValueTimePoint)
+  using ResultCallback = RH_InplaceFunction<
+    void(Value lastValue, TimePoint lastValueTimePoint)
   >;
+  using ResultCallbackRef =
+    RH_FunctionRef<typename ResultCallback::Signature>;
+
+  // Run of samples of one value, from the change at timePoint on.
+  struct Run {
+    Value value;
+    TimePoint timePoint;
+    size_t samplesCount;
+  };
+
+  using RunsCallback = RH_InplaceFunction<
+    void(const Run* runs, size_t runsCount)
+  >;
+  using RunsCallbackRef = RH_FunctionRef<typename RunsCallback::Signature>;
+
+  // Bit i is set when samples[i] differs from the sample before it,
+  // previousValue for samples[0]; samplesCount is at most 64.
+  static uint64_t changesMask(
+    const Value* samples,
+    size_t samplesCount,
+    Value previousValue
+  );
 
  protected:
   ChangeTracker(Value initialValue)
@@ -223,22 +217,154 @@ class ChangeTracker : public ChangeTrackerBase<V, TU> {
   {}
 
   void process(
-    const std::function<Value(size_t)>& dataSampleGetter,
-    const std::function<double(size_t)>& timePointGetter,
+    RH_FunctionRef<Value(size_t)> dataSampleGetter,
+    RH_FunctionRef<TimePoint(size_t)> timePointGetter,
     size_t samplesToProcess,
-    const ResultCallback& resultCallback
-  ) {
-    for(size_t i = 0; i < samplesToProcess; ++i) {
-      Value sample = dataSampleGetter(i);
-      double timePoint = timePointGetter(i);
-      if(Base::lastValue() != sample) {
-        Base::lastValue(sample);
-        Base::lastValueTimePoint(timePoint);
-        Base::resultCallback(sample, timePoint);
+    ResultCallbackRef resultCallback
+  );
+
+  // Same as above for samples and time points in arrays, with the changes
+  // run-length encoded and reported by one runsCallback call. The runs
+  // cover the samples in order; the first one continues the last run of
+  // the previous call, with its value and time point, unless the first
+  // sample is a change. The changes are found per block of 64 samples
+  // from changesMask(), so a block without any costs a vectorized compare
+  // per sample.
+  void process(
+    const Value* samples,
+    const TimePoint* timePoints,
+    size_t samplesToProcess,
+    RunsCallbackRef runsCallback
+  );
+
+  // Runs as above, a run also starting at the samples that are not
+  // changes and forceUpdate(timePoint) returns true for, in order. It is
+  // asked only in blocks forceUpdatePossible(timePoints, count) returns
+  // true for.
+  template<typename ForceUpdatePossible, typename ForceUpdate>
+  void processRuns(
+    const Value* samples,
+    const TimePoint* timePoints,
+    size_t samplesToProcess,
+    RunsCallbackRef runsCallback,
+    ForceUpdatePossible&& forceUpdatePossible,
+    ForceUpdate&& forceUpdate
+  );
+
+ private:
+  static constexpr size_t blockSamplesCount = 64;
+
+  std::vector<Run> m_runs;
+};
+
+template<typename V, typename TU>
+RH_INLINE uint64_t ChangeTracker<V, TU>::changesMask(
+  const Value* samples,
+  size_t samplesCount,
+  Value previousValue
+) {
+  if(samplesCount == 0) return 0;
+
+  // Whether any changed first: that is any sample differing from
+  // previousValue, compared with selects rather than a bool reduction so
+  // that the compiler vectorizes it.
+  Value changed{0};
+  for(size_t i = 0; i < samplesCount; ++i) {
+    changed = samples[i] != previousValue ? Value(1) : changed;
+  }
+  if(changed == Value(0)) return 0;
+
+  uint64_t mask = samples[0] != previousValue;
+  for(size_t i = 1; i < samplesCount; ++i) {
+    mask |= uint64_t(samples[i] != samples[i - 1]) << i;
+  }
+  return mask;
+}
+
+template<typename V, typename TU>
+RH_INLINE void ChangeTracker<V, TU>::process(
+  RH_FunctionRef<Value(size_t)> dataSampleGetter,
+  RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+  size_t samplesToProcess,
+  ResultCallbackRef resultCallback
+) {
+  RH_TRACE_SCOPE(samplesToProcess, 0);
+  RH_PROFILE_ZONE;
+  for(size_t i = 0; i < samplesToProcess; ++i) {
+    Value sample = dataSampleGetter(i);
+    TimePoint timePoint = timePointGetter(i);
+    if(Base::lastValue() != sample) {
+      Base::lastValue(sample);
+      Base::lastValueTimePoint(timePoint);
+      resultCallback(sample, timePoint);
+    }
+  }
+}
+
+template<typename V, typename TU>
+RH_INLINE void ChangeTracker<V, TU>::process(
+  const Value* samples,
+  const TimePoint* timePoints,
+  size_t samplesToProcess,
+  RunsCallbackRef runsCallback
+) {
+  RH_TRACE_SCOPE(samplesToProcess, 0);
+  RH_PROFILE_ZONE;
+  processRuns(samples, timePoints, samplesToProcess, runsCallback,
+              [](const TimePoint*, size_t) { return false; },
+              [](TimePoint) { return false; });
+}
+
+template<typename V, typename TU>
+template<typename ForceUpdatePossible, typename ForceUpdate>
+RH_INLINE void ChangeTracker<V, TU>::processRuns(
+  const Value* samples,
+  const TimePoint* timePoints,
+  size_t samplesToProcess,
+  RunsCallbackRef runsCallback,
+  ForceUpdatePossible&& forceUpdatePossible,
+  ForceUpdate&& forceUpdate
+) {
+  if(samplesToProcess == 0) return;
+
+  // Runs keep their first sample index in samplesCount until the end.
+  m_runs.clear();
+  m_runs.push_back(Run{Base::lastValue(), Base::lastValueTimePoint(), 0});
+  for(size_t block = 0; block < samplesToProcess;
+      block += blockSamplesCount) {
+    const size_t samplesCount =
+      std::min(blockSamplesCount, samplesToProcess - block);
+    uint64_t changes = changesMask(
+      samples + block, samplesCount,
+      block == 0 ? Base::lastValue() : samples[block - 1]);
+    if(forceUpdatePossible(timePoints + block, samplesCount)) {
+      for(size_t i = 0; i < samplesCount; ++i) {
+        const uint64_t bit = uint64_t(1) << i;
+        if(!(changes & bit) && forceUpdate(timePoints[block + i])) {
+          changes |= bit;
+        }
       }
     }
+    for(; changes; changes &= changes - 1) {
+      const size_t i = block + __builtin_ctzll(changes);
+      if(i == 0) m_runs.clear();
+      m_runs.push_back(Run{samples[i], timePoints[i], i});
+    }
   }
-};
+
+  for(size_t i = 0; i + 1 < m_runs.size(); ++i) {
+    m_runs[i].samplesCount =
+      m_runs[i + 1].samplesCount - m_runs[i].samplesCount;
+  }
+  m_runs.back().samplesCount = samplesToProcess - m_runs.back().samplesCount;
+
+  Base::lastValue(m_runs.back().value);
+  Base::lastValueTimePoint(m_runs.back().timePoint);
+  runsCallback(m_runs.data(), m_runs.size());
+}
+
+template<typename V>
+using ChangeTrackerSecond = ChangeTracker<V, Second>;
 
 template<typename V>
 using ChangeTrackerMilliSecond = ChangeTracker<V, MilliSecond>;
@@ -246,44 +372,105 @@ using ChangeTrackerMilliSecond = ChangeTracker<V, MilliSecond>;
 template<typename V, typename TU>
 class ChangeTrackerForceUpdated
     : public ChangeTracker<V, TU>,
-      public ForceUpdated
+      public ForceUpdated<TU>
 {
  private:
   using BaseChangeTracker = ChangeTracker<V, TU>;
-  using BaseForceUpdated = ForceUpdated;
+  using BaseForceUpdated = ForceUpdated<TU>;
 
  public:
   using Value = typename BaseChangeTracker::Value;
+  using TimePoint = typename BaseChangeTracker::TimePoint;
+  using Duration = typename BaseForceUpdated::Duration;
   using ResultCallback = typename BaseChangeTracker::ResultCallback;
+  using ResultCallbackRef = typename BaseChangeTracker::ResultCallbackRef;
+  using Run = typename BaseChangeTracker::Run;
+  using RunsCallback = typename BaseChangeTracker::RunsCallback;
+  using RunsCallbackRef = typename BaseChangeTracker::RunsCallbackRef;
 
  protected:
   ChangeTrackerForceUpdated(
     Value initialValue,
-    double forceUpdateTimeInterval
+    Duration forceUpdateTimeInterval
   )
       : BaseChangeTracker(initialValue),
         BaseForceUpdated(forceUpdateTimeInterval)
   {}
 
   void process(
-    const std::function<Value(size_t)>& dataSampleGetter,
-    const std::function<double(size_t)>& timePointGetter,
+    RH_FunctionRef<Value(size_t)> dataSampleGetter,
+    RH_FunctionRef<TimePoint(size_t)> timePointGetter,
     size_t samplesToProcess,
-    const ResultCallback& resultCallback
-  ) {
-    for(size_t i = 0; i < samplesToProcess; ++i) {
-      Value sample = dataSampleGetter(i);
-      double timePoint = timePointGetter(i);
-      if(BaseChangeTracker::lastValue() != sample ||
-         BaseForceUpdated::forceUpdate(timePoint)
-      ) {
-        BaseChangeTracker::lastValue(sample);
-        BaseChangeTracker::lastValueTimePoint(timePoint);
-        resultCallback(sample, timePoint);
-      }
+    ResultCallbackRef resultCallback
+  );
+
+  // Same as above for samples and time points in arrays, run-length
+  // encoded as by ChangeTracker; a forced update starts a run of the same
+  // value.
+  void process(
+    const Value* samples,
+    const TimePoint* timePoints,
+    size_t samplesToProcess,
+    RunsCallbackRef runsCallback
+  );
+
+  // Reports the last value again when a forced update is due at
+  // timePoint, as a sample of it would; when no sample came since
+  // expiryTimePoint(), from a TimingWheel timer.
+  void expire(TimePoint timePoint, ResultCallbackRef resultCallback);
+};
+
+template<typename V, typename TU>
+RH_INLINE void ChangeTrackerForceUpdated<V, TU>::process(
+  RH_FunctionRef<Value(size_t)> dataSampleGetter,
+  RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+  size_t samplesToProcess,
+  ResultCallbackRef resultCallback
+) {
+  RH_TRACE_SCOPE(samplesToProcess, 0);
+  RH_PROFILE_ZONE;
+  for(size_t i = 0; i < samplesToProcess; ++i) {
+    Value sample = dataSampleGetter(i);
+    TimePoint timePoint = timePointGetter(i);
+    if(BaseChangeTracker::lastValue() != sample ||
+       BaseForceUpdated::forceUpdate(timePoint)
+    ) {
+      BaseChangeTracker::lastValue(sample);
+      BaseChangeTracker::lastValueTimePoint(timePoint);
+      resultCallback(sample, timePoint);
     }
   }
-};
+}
+
+template<typename V, typename TU>
+RH_INLINE void ChangeTrackerForceUpdated<V, TU>::process(
+  const Value* samples,
+  const TimePoint* timePoints,
+  size_t samplesToProcess,
+  RunsCallbackRef runsCallback
+) {
+  RH_TRACE_SCOPE(samplesToProcess, 0);
+  RH_PROFILE_ZONE;
+  BaseChangeTracker::processRuns(
+    samples, timePoints, samplesToProcess, runsCallback,
+    [this](const TimePoint* blockTimePoints, size_t count) {
+      return BaseForceUpdated::forceUpdatePossible(blockTimePoints, count);
+    },
+    [this](TimePoint timePoint) {
+      return BaseForceUpdated::forceUpdate(timePoint);
+    });
+}
+
+template<typename V, typename TU>
+RH_INLINE void ChangeTrackerForceUpdated<V, TU>::expire(
+  TimePoint timePoint,
+  ResultCallbackRef resultCallback
+) {
+  if(BaseForceUpdated::forceUpdate(timePoint)) {
+    BaseChangeTracker::lastValueTimePoint(timePoint);
+    resultCallback(BaseChangeTracker::lastValue(), timePoint);
+  }
+}
 
 template<typename V>
 using ChangeTrackerForceUpdatedSecond =
@@ -293,20 +480,364 @@ template<typename V>
 using ChangeTrackerForceUpdatedMilliSecond =
   ChangeTrackerForceUpdated<V, MilliSecond>;
 
+// Counts of the samples a compressing processor took and of the points it
+// reported for them.
+class CompressionCounters {
+ public:
+  uint64_t samplesCount() const {
+    return m_samplesCount;
+  }
+
+  uint64_t pointsCount() const {
+    return m_pointsCount;
+  }
+
+  // Samples per point reported, 10 for 10:1; 0 before the first point.
+  double compressionRatio() const {
+    return m_pointsCount == 0
+      ? 0.0
+      : static_cast<double>(m_samplesCount) / m_pointsCount;
+  }
+
+ protected:
+  void samplesCounted(uint64_t count) {
+    m_samplesCount += count;
+  }
+
+  void pointCounted() {
+    ++m_pointsCount;
+  }
+
+ private:
+  uint64_t m_samplesCount = 0;
+  uint64_t m_pointsCount = 0;
+};
+
+// Historian feed reporting a sample when it leaves the deadband around the
+// last value reported, and at least every maxTimeInterval. The deadband is
+// the greater of deadband and deadbandPercent of the last value's
+// magnitude, so a sample not reported is never further than that from
+// the last value reported before it (sample and hold). The first sample
+// is always reported; NaN samples are reported when the last value is
+// not NaN and the other way round.
+template<typename V, typename TU>
+class DeadbandTracker : public CompressionCounters {
+ public:
+  using Value = V;
+  using TimePoint = TimePointOf<TU>;
+  using Duration = DurationOf<TU>;
+
+  using ResultCallback = RH_InplaceFunction<
+    void(Value lastValue, TimePoint lastValueTimePoint)
+  >;
+  using ResultCallbackRef =
+    RH_FunctionRef<typename ResultCallback::Signature>;
+
+  Value lastValue() const {
+    return m_lastValue;
+  }
+
+  template<typename U = TU>
+  TimePointOf<U> lastValueTimePoint() const {
+    return timePointCast<U, TU>(m_lastValueTimePoint);
+  }
+
+ protected:
+  DeadbandTracker(
+    Value deadband,
+    double deadbandPercent,
+    Duration maxTimeInterval
+  )
+      : m_deadband{static_cast<double>(deadband)},
+        m_deadbandRatio{deadbandPercent / 100.0},
+        m_maxTimeInterval{maxTimeInterval}
+  {}
+
+  void process(
+    RH_FunctionRef<Value(size_t)> dataSampleGetter,
+    RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+    size_t samplesToProcess,
+    ResultCallbackRef resultCallback
+  );
+
+ private:
+  bool outOfDeadband(Value sample) const;
+
+  const double m_deadband;
+  const double m_deadbandRatio;
+  const Duration m_maxTimeInterval;
+
+  Value m_lastValue{};
+  TimePoint m_lastValueTimePoint = TimeUnitTraits<TU>::noTimePoint();
+};
+
+template<typename V, typename TU>
+RH_INLINE bool DeadbandTracker<V, TU>::outOfDeadband(Value sample) const {
+  const double value = static_cast<double>(sample);
+  const double lastValue = static_cast<double>(m_lastValue);
+  if(std::isnan(value) || std::isnan(lastValue)) {
+    return std::isnan(value) != std::isnan(lastValue);
+  }
+  const double deadband =
+    std::max(m_deadband, m_deadbandRatio * std::abs(lastValue));
+  return std::abs(value - lastValue) > deadband;
+}
+
+template<typename V, typename TU>
+RH_INLINE void DeadbandTracker<V, TU>::process(
+  RH_FunctionRef<Value(size_t)> dataSampleGetter,
+  RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+  size_t samplesToProcess,
+  ResultCallbackRef resultCallback
+) {
+  RH_TRACE_SCOPE(samplesToProcess, 0);
+  RH_PROFILE_ZONE;
+  samplesCounted(samplesToProcess);
+  for(size_t i = 0; i < samplesToProcess; ++i) {
+    Value sample = dataSampleGetter(i);
+    TimePoint timePoint = timePointGetter(i);
+    if(!TimeUnitTraits<TU>::isTimePoint(m_lastValueTimePoint) ||
+       outOfDeadband(sample) ||
+       timeDistance(timePoint, m_lastValueTimePoint) >= m_maxTimeInterval
+    ) {
+      m_lastValue = sample;
+      m_lastValueTimePoint = timePoint;
+      pointCounted();
+      resultCallback(sample, timePoint);
+    }
+  }
+}
+
+template<typename V>
+using DeadbandTrackerSecond = DeadbandTracker<V, Second>;
+
 template<typename V>
+using DeadbandTrackerMilliSecond = DeadbandTracker<V, MilliSecond>;
+
+// Historian feed compressing by swinging door trending: straight lines
+// between the points reported pass within compressionDeviation of every
+// sample between them, and points are at most maxTimeInterval apart.
+//
+// Each sample narrows the two doors pivoting compressionDeviation above
+// and below the last point reported; when a sample would close them, the
+// sample before it is reported and the doors restart from there. So a
+// point is reported one sample late, and the samples after the last one
+// stay pending until flush(). A point reported is moved onto the nearest
+// line within the doors when the sample is not on one, which keeps the
+// bound; it is within compressionDeviation of the sample then (plus
+// rounding for integer values). NaN samples are reported as points of
+// their own, a run of them as its first and last sample.
+template<typename V, typename TU>
+class SwingingDoorTracker : public CompressionCounters {
+ public:
+  using Value = V;
+  using TimePoint = TimePointOf<TU>;
+  using Duration = DurationOf<TU>;
+
+  using ResultCallback = RH_InplaceFunction<
+    void(Value lastValue, TimePoint lastValueTimePoint)
+  >;
+  using ResultCallbackRef =
+    RH_FunctionRef<typename ResultCallback::Signature>;
+
+  Value lastValue() const {
+    return m_lastValue;
+  }
+
+  template<typename U = TU>
+  TimePointOf<U> lastValueTimePoint() const {
+    return timePointCast<U, TU>(m_lastValueTimePoint);
+  }
+
+ protected:
+  SwingingDoorTracker(
+    Value compressionDeviation,
+    Duration maxTimeInterval
+  )
+      : m_compressionDeviation{static_cast<double>(compressionDeviation)},
+        m_maxTimeInterval{maxTimeInterval}
+  {}
+
+  void process(
+    RH_FunctionRef<Value(size_t)> dataSampleGetter,
+    RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+    size_t samplesToProcess,
+    ResultCallbackRef resultCallback
+  );
+
+  // Reports the pending sample, if any, e.g. at the end of the data.
+  void flush(ResultCallbackRef resultCallback);
+
+ private:
+  // Narrows the doors for the sample and returns true if they stay open;
+  // leaves them as they were otherwise.
+  bool doorsOpen(Value sample, TimePoint timePoint);
+
+  // Value at timePoint of the line within the doors closest to the sample
+  // the doors were narrowed for last.
+  Value lineValue(Value sample, TimePoint timePoint) const;
+
+  void report(
+    Value sample,
+    TimePoint timePoint,
+    ResultCallbackRef resultCallback
+  );
+
+  const double m_compressionDeviation;
+  const Duration m_maxTimeInterval;
+
+  Value m_lastValue{};
+  TimePoint m_lastValueTimePoint = TimeUnitTraits<TU>::noTimePoint();
+
+  // Slopes of the doors, value per Duration unit.
+  double m_upperSlope = -std::numeric_limits<double>::infinity();
+  double m_lowerSlope = std::numeric_limits<double>::infinity();
+
+  bool m_pending = false;
+  Value m_pendingValue{};
+  TimePoint m_pendingTimePoint{};
+};
+
+template<typename V, typename TU>
+RH_INLINE bool SwingingDoorTracker<V, TU>::doorsOpen(
+  Value sample,
+  TimePoint timePoint
+) {
+  const double value = static_cast<double>(sample);
+  const double lastValue = static_cast<double>(m_lastValue);
+  if(std::isnan(value) || std::isnan(lastValue)) {
+    return std::isnan(value) && std::isnan(lastValue);
+  }
+  const double timeDuration =
+    durationCount(timePoint - m_lastValueTimePoint);
+  if(!(timeDuration > 0)) {
+    return std::abs(value - lastValue) <= m_compressionDeviation;
+  }
+  const double upperSlope = std::max(
+    m_upperSlope,
+    (value - lastValue - m_compressionDeviation) / timeDuration);
+  const double lowerSlope = std::min(
+    m_lowerSlope,
+    (value - lastValue + m_compressionDeviation) / timeDuration);
+  if(upperSlope > lowerSlope) return false;
+  m_upperSlope = upperSlope;
+  m_lowerSlope = lowerSlope;
+  return true;
+}
+
+template<typename V, typename TU>
+RH_INLINE auto SwingingDoorTracker<V, TU>::lineValue(
+  Value sample,
+  TimePoint timePoint
+) const -> Value {
+  const double value = static_cast<double>(sample);
+  const double lastValue = static_cast<double>(m_lastValue);
+  const double timeDuration =
+    durationCount(timePoint - m_lastValueTimePoint);
+  if(std::isnan(value) || std::isnan(lastValue) || !(timeDuration > 0)) {
+    return sample;
+  }
+  const double slope = (value - lastValue) / timeDuration;
+  if(m_upperSlope <= slope && slope <= m_lowerSlope) return sample;
+
+  const double line = lastValue +
+    std::min(std::max(slope, m_upperSlope), m_lowerSlope) * timeDuration;
+  if constexpr(std::is_integral_v<Value>) {
+    return static_cast<Value>(std::lround(line));
+  }
+  else return static_cast<Value>(line);
+}
+
+template<typename V, typename TU>
+RH_INLINE void SwingingDoorTracker<V, TU>::report(
+  Value sample,
+  TimePoint timePoint,
+  ResultCallbackRef resultCallback
+) {
+  m_lastValue = sample;
+  m_lastValueTimePoint = timePoint;
+  m_upperSlope = -std::numeric_limits<double>::infinity();
+  m_lowerSlope = std::numeric_limits<double>::infinity();
+  m_pending = false;
+  pointCounted();
+  resultCallback(sample, timePoint);
+}
+
+template<typename V, typename TU>
+RH_INLINE void SwingingDoorTracker<V, TU>::process(
+  RH_FunctionRef<Value(size_t)> dataSampleGetter,
+  RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+  size_t samplesToProcess,
+  ResultCallbackRef resultCallback
+) {
+  RH_TRACE_SCOPE(samplesToProcess, 0);
+  RH_PROFILE_ZONE;
+  samplesCounted(samplesToProcess);
+  for(size_t i = 0; i < samplesToProcess; ++i) {
+    Value sample = dataSampleGetter(i);
+    TimePoint timePoint = timePointGetter(i);
+    if(!TimeUnitTraits<TU>::isTimePoint(m_lastValueTimePoint)) {
+      report(sample, timePoint, resultCallback);
+      continue;
+    }
+
+    if(!doorsOpen(sample, timePoint)) {
+      // The pending sample ends the line; the doors restart from it.
+      if(m_pending) {
+        report(lineValue(m_pendingValue, m_pendingTimePoint),
+               m_pendingTimePoint, resultCallback);
+      }
+      if(!doorsOpen(sample, timePoint)) {
+        report(sample, timePoint, resultCallback);
+        continue;
+      }
+    }
+
+    if(timeDistance(timePoint, m_lastValueTimePoint) >= m_maxTimeInterval) {
+      report(lineValue(sample, timePoint), timePoint, resultCallback);
+    }
+    else {
+      m_pending = true;
+      m_pendingValue = sample;
+      m_pendingTimePoint = timePoint;
+    }
+  }
+}
+
+template<typename V, typename TU>
+RH_INLINE void SwingingDoorTracker<V, TU>::flush(
+  ResultCallbackRef resultCallback
+) {
+  if(m_pending) {
+    report(lineValue(m_pendingValue, m_pendingTimePoint),
+           m_pendingTimePoint, resultCallback);
+  }
+}
+
+template<typename V>
+using SwingingDoorTrackerSecond = SwingingDoorTracker<V, Second>;
+
+template<typename V>
+using SwingingDoorTrackerMilliSecond = SwingingDoorTracker<V, MilliSecond>;
+
+template<typename V, typename TU = void>
 class TimeWindowPeakToPeakTracker {
  public:
   using Value = V;
+  using TimePoint = TimePointOf<TU>;
+  using Duration = DurationOf<TU>;
 
-  using ResultCallback = std::function<
+  using ResultCallback = RH_InplaceFunction<
     void(
       Value lastPeakToPeakValue,
       Value lastMinValue,
       Value lastMaxValue,
-      double lastMinValueTimePoint,
-      double lastMaxValueTimePoint
+      TimePoint lastMinValueTimePoint,
+      TimePoint lastMaxValueTimePoint
     )
   >;
+  using ResultCallbackRef =
+    RH_FunctionRef<typename ResultCallback::Signature>;
 
   Value lastPeakToPeakValue() const {
     return m_lastMaxValue - m_lastMinValue;
@@ -320,50 +851,42 @@ class TimeWindowPeakToPeakTracker {
     return m_lastMaxValue;
   }
 
- protected:
-  TimeWindowPeakToPeakTracker(double timeWindowToTrack)
-      : m_timeWindowToTrack(timeWindowToTrack)
-  {
+  void timeWindowToTrack(Duration value) {
+    m_timeWindowToTrack = value;
     resetValues();
   }
 
-  void timeWindowToTrack(double value) const {
-    m_timeWindowToTrack = value;
-    resetValues();
+  template<typename U = TU>
+  DurationOf<U> timeWindowToTrack() const {
+    return durationCast<U, TU>(m_timeWindowToTrack);
   }
 
-  double timeWindowToTrack() const {
-    return m_timeWindowToTrack;
+  template<typename U = TU>
+  TimePointOf<U> lastMinValueTimePoint() const {
+    return timePointCast<U, TU>(m_lastMinValueTimePoint);
   }
 
-  double lastMinValueTimePoint() const {
-    return m_lastMinValueTimePoint;
+  template<typename U = TU>
+  TimePointOf<U> lastMaxValueTimePoint() const {
+    return timePointCast<U, TU>(m_lastMaxValueTimePoint);
   }
 
-  double lastMaxValueTimePoint() const {
-    return m_lastMaxValueTimePoint;
+ protected:
+  TimeWindowPeakToPeakTracker(Duration timeWindowToTrack)
+      : m_timeWindowToTrack(timeWindowToTrack)
+  {
+    resetValues();
   }
 
   void process(
-    const std::function<Value(size_t)>& dataSampleGetter,
-    const std::function<double(size_t)>& timePointGetter,
+    RH_FunctionRef<Value(size_t)> dataSampleGetter,
+    RH_FunctionRef<TimePoint(size_t)> timePointGetter,
     size_t samplesToProcess,
-    const ResultCallback& resultCallback
-  ) {
-    for(size_t i = 0; i < samplesToProcess; ++i) {
-      if(
-        updateLastValuesUsingTimeWindow(
-          dataSampleGetter(i), timePointGetter(i))
-      ) {
-        resultCallback(
-          lastPeakToPeakValue(), lastMinValue(), lastMaxValue(),
-          lastMinValueTimePoint(), lastMaxValueTimePoint());
-      }
-    }
-  }
+    ResultCallbackRef resultCallback
+  );
 
  private:
-  bool updateLastValuesUsingTimeWindow(Value value, double timePoint) {
+  bool updateLastValuesUsingTimeWindow(Value value, TimePoint timePoint) {
     track(value, timePoint);
     if((timePoint - m_valuesUpdateTimePoint) >= m_timeWindowToTrack) {
       m_valuesUpdateTimePoint = timePoint;
@@ -377,7 +900,7 @@ class TimeWindowPeakToPeakTracker {
     return false;
   }
 
-  void track(Value value, double timePoint) {
+  void track(Value value, TimePoint timePoint) {
     if(value > m_maxValue) {
       m_maxValue = value;
       m_maxValueTimePoint = timePoint;
@@ -405,62 +928,61 @@ class TimeWindowPeakToPeakTracker {
 
   void resetValues() {
     m_maxValue = std::numeric_limits<Value>::lowest();
-    m_maxValueTimePoint = std::numeric_limits<double>::quiet_NaN();
+    m_maxValueTimePoint = TimeUnitTraits<TU>::noTimePoint();
     m_minValue = std::numeric_limits<Value>::max();
-    m_minValueTimePoint = std::numeric_limits<double>::quiet_NaN();
+    m_minValueTimePoint = TimeUnitTraits<TU>::noTimePoint();
   }
 
-  const double m_timeWindowToTrack;
-  double m_valuesUpdateTimePoint{0};
+  Duration m_timeWindowToTrack;
+  TimePoint m_valuesUpdateTimePoint{};
 
   Value m_maxValue;
-  double m_maxValueTimePoint;
+  TimePoint m_maxValueTimePoint;
   Value m_minValue;
-  double m_minValueTimePoint;
+  TimePoint m_minValueTimePoint;
 
   Value m_lastMaxValue{std::numeric_limits<Value>::lowest()};
-  double m_lastMaxValueTimePoint{std::numeric_limits<double>::quiet_NaN()};
+  TimePoint m_lastMaxValueTimePoint{TimeUnitTraits<TU>::noTimePoint()};
   Value m_lastMinValue{std::numeric_limits<Value>::max()};
-  double m_lastMinValueTimePoint{std::numeric_limits<double>::quiet_NaN()};
+  TimePoint m_lastMinValueTimePoint{TimeUnitTraits<TU>::noTimePoint()};
 };
 
-template<typename V>
-class TimeWindowPeakToPeakTrackerSecond
-    : public TimeWindowPeakToPeakTracker<V>
-{
- private:
-  using Base = TimeWindowPeakToPeakTracker<V>;
-
- public:
-  void timeWindowToTrackSecond(double value) const {
-    Base::timeWindowToTrack(value);
-  }
-
-  double timeWindowToTrackSecond() const {
-    return Base::timeWindowToTrack();
-  }
-
-  double lastMinValueTimePointSecond() const {
-    return Base::lastMinValueTimePoint();
-  }
-
-  double lastMaxValueTimePointSecond() const {
-    return Base::lastMaxValueTimePoint();
+template<typename V, typename TU>
+RH_INLINE void TimeWindowPeakToPeakTracker<V, TU>::process(
+  RH_FunctionRef<Value(size_t)> dataSampleGetter,
+  RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+  size_t samplesToProcess,
+  ResultCallbackRef resultCallback
+) {
+  RH_TRACE_SCOPE(samplesToProcess, 0);
+  RH_PROFILE_ZONE;
+  for(size_t i = 0; i < samplesToProcess; ++i) {
+    if(
+      updateLastValuesUsingTimeWindow(
+        dataSampleGetter(i), timePointGetter(i))
+    ) {
+      resultCallback(
+        lastPeakToPeakValue(), lastMinValue(), lastMaxValue(),
+        lastMinValueTimePoint(), lastMaxValueTimePoint());
+    }
   }
-
- protected:
-  TimeWindowPeakToPeakTrackerSecond(double timeWindowToTrack)
-      : Base(timeWindowToTrack)
-  {}
-};
+}
 
 template<typename V>
+using TimeWindowPeakToPeakTrackerSecond =
+  TimeWindowPeakToPeakTracker<V, Second>;
+
+template<typename V, typename T = double, typename D = double>
 class TimeAccumulateProcessorUnitlessBase {
  public:
   using Value = V;
+  using TimePoint = T;
+  using Duration = D;
 
   using ResultCallback =
-    std::function<void(Value lastValue, double lastValueTimePoint)>;
+    RH_InplaceFunction<void(Value lastValue, TimePoint lastValueTimePoint)>;
+  using ResultCallbackRef =
+    RH_FunctionRef<typename ResultCallback::Signature>;
 
   Value lastValue() const {
     return m_lastValue;
@@ -468,7 +990,7 @@ class TimeAccumulateProcessorUnitlessBase {
 
  protected:
   TimeAccumulateProcessorUnitlessBase(
-    double timeDurationToProcess,
+    Duration timeDurationToProcess,
     Value lastValueInitial
   )
       : m_timeDurationToProcess{timeDurationToProcess},
@@ -479,137 +1001,94 @@ class TimeAccumulateProcessorUnitlessBase {
   virtual Value lastValueCompute() =0;
   virtual void accumulatorReset() =0;
 
-  void timeDurationToProcess(double value) {
-    m_timeDurationToProcess = value;
+  void accumulateSample(Value value) {
+    accumulate(value);
+    ++m_samplesAccumulated;
+  }
+
+  size_t samplesAccumulated() const {
+    return m_samplesAccumulated;
+  }
+
+  // accumulatorReset() with the samples accumulated counted from 0.
+  void accumulatorClear() {
     accumulatorReset();
+    m_samplesAccumulated = 0;
   }
 
-  double timeDurationToProcess() const {
+  void timeDurationToProcess(Duration value) {
+    m_timeDurationToProcess = value;
+    accumulatorClear();
+  }
+
+  Duration timeDurationToProcess() const {
     return m_timeDurationToProcess;
   }
 
-  double lastValueTimePoint() const {
+  TimePoint lastValueTimePoint() const {
     return m_lastValueTimePoint;
   }
 
-  void lastValueTimePoint(double value) {
+  void lastValueTimePoint(TimePoint value) {
     m_lastValueTimePoint = value;
   }
 
-  bool updateLastValue(double timePoint) {
+  bool updateLastValue(TimePoint timePoint) {
     bool valueUpdated = false;
-    double timeDuration = std::abs(timePoint - m_lastValueTimePoint);
+    Duration timeDuration = timeDistance(timePoint, m_lastValueTimePoint);
     if(timeDuration >= m_timeDurationToProcess) {
       m_lastValue = lastValueCompute();
       m_lastValueTimePoint = timePoint;
-      accumulatorReset();
+      accumulatorClear();
       valueUpdated = true;
     }
     return valueUpdated;
   }
 
  private:
-  double m_timeDurationToProcess;
+  Duration m_timeDurationToProcess;
   Value m_lastValue;
-  double m_lastValueTimePoint{0};
+  TimePoint m_lastValueTimePoint{};
+  size_t m_samplesAccumulated{0};
 };
 
 template<typename V, typename TU>
-class TimeAccumulateProcessorBase;
-
-template<typename V>
-class TimeAccumulateProcessorBase<V, void>
-    : public TimeAccumulateProcessorUnitlessBase<V>
-{
- private:
-  using Base = TimeAccumulateProcessorUnitlessBase<V>;
-
- public:
-  using Value = typename Base::Value;
-
-  double lastValueTimePoint() const {
-    return Base::lastValueTimePoint();
-  }
-
- protected:
-  TimeAccumulateProcessorBase(
-    double timeDurationToProcess,
-    Value lastValueInitial
-  )
-      : Base(timeDurationToProcess, lastValueInitial)
-  {}
-
-  void lastValueTimePoint(double value) {
-    Base::lastValueTimePoint(value);
-  }
-};
-
-template<typename V>
-class TimeAccumulateProcessorBase<V, Second>
-    : public TimeAccumulateProcessorUnitlessBase<V>
+class TimeAccumulateProcessorBase
+    : public TimeAccumulateProcessorUnitlessBase<
+        V, TimePointOf<TU>, DurationOf<TU>>
 {
  private:
-  using Base = TimeAccumulateProcessorUnitlessBase<V>;
-
-  double lastValueTimePointSecond() const {
-    return Base::lastValueTimePoint();
-  }
+  using Base =
+    TimeAccumulateProcessorUnitlessBase<V, TimePointOf<TU>, DurationOf<TU>>;
 
  public:
   using Value = typename Base::Value;
+  using TimePoint = typename Base::TimePoint;
+  using Duration = typename Base::Duration;
 
-  double timeDurationToProcessSecond() const {
-    return Base::timeDurationToProcess();
+  template<typename U = TU>
+  TimePointOf<U> lastValueTimePoint() const {
+    return timePointCast<U, TU>(Base::lastValueTimePoint());
   }
 
- protected:
-  TimeAccumulateProcessorBase(
-    double timeDurationToProcessSecond,
-    Value lastValueInitial
-  )
-      : Base(timeDurationToProcessSecond, lastValueInitial)
-  {}
-
-  void lastValueTimePointSecond(double value) {
-    Base::lastValueTimePoint(value);
-  }
-
-  void timeDurationToProcessSecond(double value) {
-    Base::timeDurationToProcess(value);
-  }
-};
-
-template<typename V>
-class TimeAccumulateProcessorBase<V, MilliSecond>
-    : public TimeAccumulateProcessorUnitlessBase<V>
-{
- private:
-  using Base = TimeAccumulateProcessorUnitlessBase<V>;
-
- public:
-  using Value = typename Base::Value;
-
-  double lastValueTimePointMilliSecond() const {
-    return Base::lastValueTimePoint();
-  }
-
-  double timeDurationToProcessMilliSecond() const {
-    return Base::timeDurationToProcess();
+  template<typename U = TU>
+  DurationOf<U> timeDurationToProcess() const {
+    return durationCast<U, TU>(Base::timeDurationToProcess());
   }
 
  protected:
   TimeAccumulateProcessorBase(
-    double timeDurationToProcessMilliSecond,
+    Duration timeDurationToProcess,
     Value lastValueInitial
   )
-      : Base(timeDurationToProcessMilliSecond, lastValueInitial)
+      : Base(timeDurationToProcess, lastValueInitial)
   {}
 
-  void lastValueTimePointMilliSecond(double value) {
+  void lastValueTimePoint(TimePoint value) {
     Base::lastValueTimePoint(value);
   }
 
-  void timeDurationToProcessMilliSecond(double value) {
+  void timeDurationToProcess(Duration value) {
     Base::timeDurationToProcess(value);
   }
 };
@@ -621,28 +1100,41 @@ class TimeAccumulateProcessor : public TimeAccumulateProcessorBase<V, TU> {
 
  public:
   using Value = V;
+  using TimePoint = typename Base::TimePoint;
+  using Duration = typename Base::Duration;
   using ResultCallback = typename Base::ResultCallback;
+  using ResultCallbackRef = typename Base::ResultCallbackRef;
+
+  // Time point from which the value of the samples accumulated so far is
+  // due, no time point when there are none; for a TimingWheel timer.
+  template<typename U = TU>
+  TimePointOf<U> expiryTimePoint() const {
+    if(Base::samplesAccumulated() == 0) {
+      return TimeUnitTraits<U>::noTimePoint();
+    }
+    return timePointCast<U, TU>(
+      Base::lastValueTimePoint() + Base::timeDurationToProcess());
+  }
 
  protected:
-  TimeAccumulateProcessor(double timeDurationToProcess, Value lastValueInitial)
+  TimeAccumulateProcessor(
+    Duration timeDurationToProcess,
+    Value lastValueInitial
+  )
       : Base(timeDurationToProcess, lastValueInitial)
   {}
 
   void process(
-    const std::function<Value(size_t)>& dataSampleGetter,
-    const std::function<double(size_t)>& timePointGetter,
+    RH_FunctionRef<Value(size_t)> dataSampleGetter,
+    RH_FunctionRef<TimePoint(size_t)> timePointGetter,
     size_t samplesToProcess,
-    const ResultCallback& resultCallback
-  ) {
-    m_processingStopped = false;
-    for(size_t i = 0; i < samplesToProcess; ++i) {
-      this->accumulate(dataSampleGetter(i));
-      if(Base::updateLastValue(timePointGetter(i))) {
-        resultCallback(Base::lastValue(), Base::lastValueTimePoint());
-        if(m_processingStopped) break;
-      }
-    }
-  }
+    ResultCallbackRef resultCallback
+  );
+
+  // Reports the value of the samples accumulated so far when it is due at
+  // timePoint, as a sample would; when no sample came since
+  // expiryTimePoint(), from a TimingWheel timer.
+  void expire(TimePoint timePoint, ResultCallbackRef resultCallback);
 
   void stopProcessing() {
     m_processingStopped = true;
@@ -652,6 +1144,35 @@ class TimeAccumulateProcessor : public TimeAccumulateProcessorBase<V, TU> {
   bool m_processingStopped;
 };
 
+template<typename V, typename TU>
+RH_INLINE void TimeAccumulateProcessor<V, TU>::process(
+  RH_FunctionRef<Value(size_t)> dataSampleGetter,
+  RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+  size_t samplesToProcess,
+  ResultCallbackRef resultCallback
+) {
+  RH_TRACE_SCOPE(samplesToProcess, 0);
+  RH_PROFILE_ZONE;
+  m_processingStopped = false;
+  for(size_t i = 0; i < samplesToProcess; ++i) {
+    Base::accumulateSample(dataSampleGetter(i));
+    if(Base::updateLastValue(timePointGetter(i))) {
+      resultCallback(Base::lastValue(), Base::lastValueTimePoint());
+      if(m_processingStopped) break;
+    }
+  }
+}
+
+template<typename V, typename TU>
+RH_INLINE void TimeAccumulateProcessor<V, TU>::expire(
+  TimePoint timePoint,
+  ResultCallbackRef resultCallback
+) {
+  if(Base::samplesAccumulated() > 0 && Base::updateLastValue(timePoint)) {
+    resultCallback(Base::lastValue(), Base::lastValueTimePoint());
+  }
+}
+
 template<typename V, typename TU>
 class TimeAverager : public TimeAccumulateProcessor<V, TU> {
  private:
@@ -659,9 +1180,10 @@ class TimeAverager : public TimeAccumulateProcessor<V, TU> {
 
  public:
   using Value = typename Base::Value;
+  using Duration = typename Base::Duration;
 
  protected:
-  TimeAverager(double timeDurationToAverage, Value lastValueInitial)
+  TimeAverager(Duration timeDurationToAverage, Value lastValueInitial)
       : Base(timeDurationToAverage, lastValueInitial)
   {
     accumulatorReset();
@@ -699,9 +1221,10 @@ class TimeRmseProcessor : public TimeAccumulateProcessor<V, TU> {
 
  public:
   using Value = typename Base::Value;
+  using Duration = typename Base::Duration;
 
  protected:
-  TimeRmseProcessor(double timeDurationToProcess, Value lastValueInitial)
+  TimeRmseProcessor(Duration timeDurationToProcess, Value lastValueInitial)
       : Base(timeDurationToProcess, lastValueInitial)
   {
     accumulatorReset();
@@ -744,9 +1267,10 @@ class TimeSdProcessor : public TimeAccumulateProcessor<V, TU> {
 
  public:
   using Value = typename Base::Value;
+  using Duration = typename Base::Duration;
 
   TimeSdProcessor(
-    double timeDurationToProcess,
+    Duration timeDurationToProcess,
     Value lastValueInitial
   )
       : Base(timeDurationToProcess, lastValueInitial)
@@ -785,23 +1309,36 @@ class TimeSdProcessor : public TimeAccumulateProcessor<V, TU> {
 template<typename V>
 using TimeSecondSdProcessor = TimeSdProcessor<V, Second>;
 
-template<typename V>
-class ForwardProcessorBuffered : public Buffered<V> {
+template<typename V, typename TU = void>
+class ForwardProcessorBuffered : public Buffered<V, TimePointOf<TU>> {
  private:
-  using Base = Buffered<V>;
+  using Base = Buffered<V, TimePointOf<TU>>;
 
  public:
   using Value = typename Base::Value;
+  using TimePoint = typename Base::TimePoint;
   using BufferSPtr = typename Base::BufferSPtr;
 
-  using ResultCallback = std::function<
-    void(BufferSPtr bufferCopySPtr, double bufferTimePoint)
+  using ResultCallback = RH_InplaceFunction<
+    void(BufferSPtr bufferCopySPtr, TimePoint bufferTimePoint)
   >;
+  using ResultCallbackRef =
+    RH_FunctionRef<typename ResultCallback::Signature>;
 
   Value lastValue() const {
     return m_lastValue;
   }
 
+  template<typename U = TU>
+  TimePointOf<U> lastValueTimePoint() const {
+    return timePointCast<U, TU>(m_lastValueTimePoint);
+  }
+
+  template<typename U = TU>
+  TimePointOf<U> bufferTimePoint() const {
+    return timePointCast<U, TU>(Base::bufferTimePoint());
+  }
+
   size_t samplesToBuffer() const {
     return Base::samplesToBuffer();
   }
@@ -817,85 +1354,77 @@ class ForwardProcessorBuffered : public Buffered<V> {
   )
       : Base(samplesToBuffer),
         m_lastValue(lastValueInitial),
-        m_lastValueTimePoint(0)
+        m_lastValueTimePoint{}
   {}
 
   void process(
-    const std::function<Value(size_t)>& dataSampleGetter,
-    const std::function<double(size_t)>& timePointGetter,
+    RH_FunctionRef<Value(size_t)> dataSampleGetter,
+    RH_FunctionRef<TimePoint(size_t)> timePointGetter,
     size_t samplesToProcess,
-    const ResultCallback& resultCallback
-  ) {
-    for(size_t i = 0; i < samplesToProcess; ++i) {
-      m_lastValue = dataSampleGetter(i);
-      m_lastValueTimePoint = timePointGetter(i);
-      Base::buffer().push_back(m_lastValue);
-      if(Base::buffer().size() == 1) {
-        Base::bufferTimePoint(m_lastValueTimePoint);
-      }
-      if(Base::buffer().size() == Base::samplesToBuffer()) {
-        resultCallback(Base::bufferCopySPtr(), Base::bufferTimePoint());
-        Base::buffer().clear();
-      }
-    }
-  }
+    ResultCallbackRef resultCallback
+  );
 
   void samplesToBuffer(size_t value) {
     Base::samplesToBuffer(value);
   }
 
-  double lastValueTimePoint() const {
-    return m_lastValueTimePoint;
-  }
-
  private:
   Value m_lastValue;
-  double m_lastValueTimePoint;
+  TimePoint m_lastValueTimePoint;
 };
 
-template<typename V>
-class ForwardProcessorBufferedMilliSecond
-    : public ForwardProcessorBuffered<V>
-{
- private:
-  using Base = ForwardProcessorBuffered<V>;
-
- public:
-  using Value = typename Base::Value;
-
-  double lastValueTimePointMilliSecond() const {
-    return Base::lastValueTimePoint();
-  }
-
-  double bufferTimePointMilliSecond() const {
-    return Base::bufferTimePoint();
+template<typename V, typename TU>
+RH_INLINE void ForwardProcessorBuffered<V, TU>::process(
+  RH_FunctionRef<Value(size_t)> dataSampleGetter,
+  RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+  size_t samplesToProcess,
+  ResultCallbackRef resultCallback
+) {
+  RH_TRACE_SCOPE(samplesToProcess, 0);
+  RH_PROFILE_ZONE;
+  for(size_t i = 0; i < samplesToProcess; ++i) {
+    m_lastValue = dataSampleGetter(i);
+    m_lastValueTimePoint = timePointGetter(i);
+    Base::buffer().push_back(m_lastValue);
+    if(Base::buffer().size() == 1) {
+      Base::bufferTimePoint(m_lastValueTimePoint);
+    }
+    if(Base::buffer().size() == Base::samplesToBuffer()) {
+      resultCallback(Base::bufferCopySPtr(), Base::bufferTimePoint());
+      Base::buffer().clear();
+    }
   }
+}
 
- protected:
-  ForwardProcessorBufferedMilliSecond(
-    size_t samplesToBuffer,
-    Value lastValueInitial
-  )
-      : Base(samplesToBuffer, lastValueInitial)
-  {}
-};
+template<typename V>
+using ForwardProcessorBufferedMilliSecond =
+  ForwardProcessorBuffered<V, MilliSecond>;
 
 template<typename V, typename TU>
 class TimeAveragerBuffered
     : public TimeAverager<V, TU>,
-      public Buffered<V>
+      public Buffered<V, TimePointOf<TU>>
 {
  private:
   using BaseTimeAverager = TimeAverager<V, TU>;
-  using BaseBuffered = Buffered<V>;
+  using BaseBuffered = Buffered<V, TimePointOf<TU>>;
 
  public:
   using Value = typename BaseTimeAverager::Value;
+  using TimePoint = typename BaseTimeAverager::TimePoint;
+  using Duration = typename BaseTimeAverager::Duration;
   using BufferSPtr = typename BaseBuffered::BufferSPtr;
 
-  using ResultCallback = std::function<
-    void(BufferSPtr bufferCopySPtr, double bufferTimePoint)
+  using ResultCallback = RH_InplaceFunction<
+    void(BufferSPtr bufferCopySPtr, TimePoint bufferTimePoint)
   >;
+  using ResultCallbackRef =
+    RH_FunctionRef<typename ResultCallback::Signature>;
+
+  template<typename U = TU>
+  TimePointOf<U> bufferTimePoint() const {
+    return timePointCast<U, TU>(BaseBuffered::bufferTimePoint());
+  }
 
   size_t samplesToBuffer() {
     return BaseBuffered::samplesToBuffer();
@@ -903,17 +1432,17 @@ class TimeAveragerBuffered
 
   void samplesToBuffer(size_t value) {
     BaseBuffered::samplesToBuffer(value);
-    BaseTimeAverager::accumulatorReset();
+    BaseTimeAverager::accumulatorClear();
   }
 
   void reset() {
     BaseBuffered::bufferReset();
-    BaseTimeAverager::accumulatorReset();
+    BaseTimeAverager::accumulatorClear();
   }
 
  protected:
   TimeAveragerBuffered(
-    double timeDurationToAverage,
+    Duration timeDurationToAverage,
     size_t samplesToBuffer,
     Value lastValueInitial
   )
@@ -922,62 +1451,309 @@ class TimeAveragerBuffered
   {}
 
   void process(
-    const std::function<Value(size_t)>& dataSampleGetter,
-    const std::function<double(size_t)>& timePointGetter,
+    RH_FunctionRef<Value(size_t)> dataSampleGetter,
+    RH_FunctionRef<TimePoint(size_t)> timePointGetter,
     size_t samplesToProcess,
-    const ResultCallback& resultCallback
-  ) {
-    using Avr = BaseTimeAverager;
-    using Buf = BaseBuffered;
-    for(size_t i = 0; i < samplesToProcess; ++i) {
-      this->accumulate(dataSampleGetter(i));
-      double timePoint = timePointGetter(i);
-      if(Avr::updateLastValue(timePoint)) {
-        Buf::buffer().push_back(Avr::lastValue());
-        if(Buf::buffer().size() == 1) {
-          Buf::bufferTimePoint(Avr::lastValueTimePoint());
-        }
-        if(Buf::buffer().size() == Buf::samplesToBuffer()) {
-          resultCallback(Buf::bufferCopySPtr(), Buf::bufferTimePoint());
-          Buf::buffer().clear();
-        }
-      }
-    }
-  }
-};
+    ResultCallbackRef resultCallback
+  );
+
+  // As TimeAccumulateProcessor::expire(), the value due buffered.
+  void expire(TimePoint timePoint, ResultCallbackRef resultCallback);
 
-template<typename V>
-class TimeAveragerBufferedMilliSecond
-    : public TimeAveragerBuffered<V, MilliSecond>
-{
  private:
-  using Base = TimeAveragerBuffered<V, MilliSecond>;
+  void bufferLastValue(ResultCallbackRef resultCallback);
+};
+
+template<typename V, typename TU>
+RH_INLINE void TimeAveragerBuffered<V, TU>::process(
+  RH_FunctionRef<Value(size_t)> dataSampleGetter,
+  RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+  size_t samplesToProcess,
+  ResultCallbackRef resultCallback
+) {
+  RH_TRACE_SCOPE(samplesToProcess, 0);
+  RH_PROFILE_ZONE;
+  using Avr = BaseTimeAverager;
+  for(size_t i = 0; i < samplesToProcess; ++i) {
+    Avr::accumulateSample(dataSampleGetter(i));
+    TimePoint timePoint = timePointGetter(i);
+    if(Avr::updateLastValue(timePoint)) bufferLastValue(resultCallback);
+  }
+}
+
+template<typename V, typename TU>
+RH_INLINE void TimeAveragerBuffered<V, TU>::expire(
+  TimePoint timePoint,
+  ResultCallbackRef resultCallback
+) {
+  using Avr = BaseTimeAverager;
+  if(Avr::samplesAccumulated() > 0 && Avr::updateLastValue(timePoint)) {
+    bufferLastValue(resultCallback);
+  }
+}
+
+template<typename V, typename TU>
+RH_INLINE void TimeAveragerBuffered<V, TU>::bufferLastValue(
+  ResultCallbackRef resultCallback
+) {
+  using Avr = BaseTimeAverager;
+  using Buf = BaseBuffered;
+  Buf::buffer().push_back(Avr::lastValue());
+  if(Buf::buffer().size() == 1) {
+    Buf::bufferTimePoint(Avr::lastValueTimePoint());
+  }
+  if(Buf::buffer().size() == Buf::samplesToBuffer()) {
+    resultCallback(Buf::bufferCopySPtr(), Buf::bufferTimePoint());
+    Buf::buffer().clear();
+  }
+}
 
+template<typename V>
+using TimeAveragerBufferedMilliSecond = TimeAveragerBuffered<V, MilliSecond>;
+
+// Downsampling for trend display by Largest Triangle Three Buckets: the
+// first sample, then one sample per bucket of samplesPerBucket, the one
+// making the largest triangle with the sample taken before it and the
+// average of the next bucket. So a bucket is taken when the next one is
+// complete. The points taken are reported bucketsToBuffer at a time, in
+// buffers from a pool: a buffer is filled again once the callback and
+// whoever it passed the buffer to have dropped it; flush() takes the
+// buckets pending and the last sample and reports the points not
+// reported yet. Time is O(1) per sample and memory O(samplesPerBucket +
+// bucketsToBuffer); both must be nonzero, std::invalid_argument is thrown
+// otherwise.
+template<typename V, typename TU = void>
+class LttbProcessorBuffered {
  public:
-  using Value = typename Base::Value;
+  using Value = V;
+  using TimePoint = TimePointOf<TU>;
+
+  struct Point {
+    Value value;
+    TimePoint timePoint;
+  };
+
+  using Points = std::vector<Point>;
+  using PointsSPtr = std::shared_ptr<const Points>;
+
+  using ResultCallback = RH_InplaceFunction<
+    void(PointsSPtr pointsSPtr, TimePoint bufferTimePoint)
+  >;
+  using ResultCallbackRef =
+    RH_FunctionRef<typename ResultCallback::Signature>;
+
+  // The sample taken last.
+  Value lastValue() const {
+    return m_lastPoint.value;
+  }
+
+  template<typename U = TU>
+  TimePointOf<U> lastValueTimePoint() const {
+    return timePointCast<U, TU>(m_lastPoint.timePoint);
+  }
+
+  size_t samplesPerBucket() const {
+    return m_samplesPerBucket;
+  }
 
-  double bufferTimePointMilliSecond() const {
-    return Base::bufferTimePoint();
+  size_t bucketsToBuffer() const {
+    return m_bucketsToBuffer;
   }
 
-  double samplingIntervalMilliSecond() const {
-    return Base::samplingInterval();
+  void reset() {
+    m_started = false;
+    m_bucket.clear();
+    m_nextBucket.clear();
+    m_points->clear();
   }
 
  protected:
-  TimeAveragerBufferedMilliSecond(
-    double timeDurationToAverage,
-    size_t samplesToBuffer,
-    Value lastValueInitial
+  LttbProcessorBuffered(
+    size_t samplesPerBucket,
+    size_t bucketsToBuffer
   )
-      : Base(timeDurationToAverage, samplesToBuffer, lastValueInitial)
-  {}
-
-  void samplingIntervalMilliSecond(double value) {
-    Base::samplingInterval(value);
+      : m_samplesPerBucket{samplesPerBucket},
+        m_bucketsToBuffer{bucketsToBuffer}
+  {
+    if(m_samplesPerBucket == 0 || m_bucketsToBuffer == 0) {
+      throw std::invalid_argument(
+        "LttbProcessorBuffered: zero samples per bucket or buckets to buffer");
+    }
+    m_bucket.reserve(m_samplesPerBucket);
+    m_nextBucket.reserve(m_samplesPerBucket);
+    m_points = pooledPoints();
   }
+
+  void process(
+    RH_FunctionRef<Value(size_t)> dataSampleGetter,
+    RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+    size_t samplesToProcess,
+    ResultCallbackRef resultCallback
+  );
+
+  // Takes a point of each bucket pending and the last sample, then
+  // reports the points not reported yet, in a buffer that may hold fewer
+  // than bucketsToBuffer; e.g. at the end of the data. Samples processed
+  // after it go on from the last sample.
+  void flush(ResultCallbackRef resultCallback);
+
+ private:
+  using Bucket = std::vector<Point>;
+
+  // The point of bucket with the largest triangle between the last point
+  // and the average of nextBucket; the first one if all areas are NaN.
+  Point largestTrianglePoint(
+    const Bucket& bucket,
+    const Bucket& nextBucket
+  ) const;
+
+  void take(Point point, ResultCallbackRef resultCallback);
+
+  // A buffer of the pool no one else holds, or a new one.
+  std::shared_ptr<Points> pooledPoints();
+
+  const size_t m_samplesPerBucket;
+  const size_t m_bucketsToBuffer;
+
+  bool m_started = false;
+  Point m_lastPoint{};
+  Bucket m_bucket;
+  Bucket m_nextBucket;
+
+  std::shared_ptr<Points> m_points;
+  std::vector<std::shared_ptr<Points>> m_pointsPool;
 };
 
+template<typename V, typename TU>
+RH_INLINE auto LttbProcessorBuffered<V, TU>::largestTrianglePoint(
+  const Bucket& bucket,
+  const Bucket& nextBucket
+) const -> Point {
+  // Time as duration since the last point, so Ticks work too.
+  double nextTime = 0;
+  double nextValue = 0;
+  for(const Point& point : nextBucket) {
+    nextTime += durationCount(point.timePoint - m_lastPoint.timePoint);
+    nextValue += static_cast<double>(point.value);
+  }
+  nextTime /= nextBucket.size();
+  nextValue /= nextBucket.size();
+
+  const double lastValue = static_cast<double>(m_lastPoint.value);
+  size_t largestIndex = 0;
+  double largestArea = -1;
+  for(size_t i = 0; i < bucket.size(); ++i) {
+    const double time =
+      durationCount(bucket[i].timePoint - m_lastPoint.timePoint);
+    const double value = static_cast<double>(bucket[i].value);
+    // Twice the area, with the last point at time 0.
+    const double area = std::abs(time * (nextValue - lastValue) -
+                                 nextTime * (value - lastValue));
+    if(area > largestArea) {
+      largestArea = area;
+      largestIndex = i;
+    }
+  }
+  return bucket[largestIndex];
+}
+
+template<typename V, typename TU>
+RH_INLINE void LttbProcessorBuffered<V, TU>::take(
+  Point point,
+  ResultCallbackRef resultCallback
+) {
+  m_lastPoint = point;
+  m_points->push_back(point);
+  if(m_points->size() == m_bucketsToBuffer) {
+    const TimePoint bufferTimePoint = m_points->front().timePoint;
+    resultCallback(m_points, bufferTimePoint);
+    m_points = pooledPoints();
+  }
+}
+
+template<typename V, typename TU>
+RH_INLINE auto LttbProcessorBuffered<V, TU>::pooledPoints()
+  -> std::shared_ptr<Points>
+{
+  for(const std::shared_ptr<Points>& points : m_pointsPool) {
+    if(points.use_count() == 1) {
+      // Pairs with the release of the last other owner's drop.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      points->clear();
+      return points;
+    }
+  }
+  m_pointsPool.push_back(std::make_shared<Points>());
+  m_pointsPool.back()->reserve(m_bucketsToBuffer);
+  return m_pointsPool.back();
+}
+
+template<typename V, typename TU>
+RH_INLINE void LttbProcessorBuffered<V, TU>::process(
+  RH_FunctionRef<Value(size_t)> dataSampleGetter,
+  RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+  size_t samplesToProcess,
+  ResultCallbackRef resultCallback
+) {
+  RH_TRACE_SCOPE(samplesToProcess, 0);
+  RH_PROFILE_ZONE;
+  for(size_t i = 0; i < samplesToProcess; ++i) {
+    const Point point{dataSampleGetter(i), timePointGetter(i)};
+    if(!m_started) {
+      m_started = true;
+      take(point, resultCallback);
+      continue;
+    }
+
+    m_nextBucket.push_back(point);
+    if(m_nextBucket.size() == m_samplesPerBucket) {
+      if(!m_bucket.empty()) {
+        take(largestTrianglePoint(m_bucket, m_nextBucket), resultCallback);
+      }
+      std::swap(m_bucket, m_nextBucket);
+      m_nextBucket.clear();
+    }
+  }
+}
+
+template<typename V, typename TU>
+RH_INLINE void LttbProcessorBuffered<V, TU>::flush(
+  ResultCallbackRef resultCallback
+) {
+  // The last sample is a bucket of its own, unless taken already.
+  Bucket lastBucket;
+  if(!m_nextBucket.empty()) {
+    lastBucket.push_back(m_nextBucket.back());
+    m_nextBucket.pop_back();
+  }
+  else if(!m_bucket.empty()) {
+    lastBucket.push_back(m_bucket.back());
+    m_bucket.pop_back();
+  }
+
+  if(!m_bucket.empty()) {
+    take(largestTrianglePoint(
+           m_bucket, m_nextBucket.empty() ? lastBucket : m_nextBucket),
+         resultCallback);
+  }
+  if(!m_nextBucket.empty()) {
+    take(largestTrianglePoint(m_nextBucket, lastBucket), resultCallback);
+  }
+  if(!lastBucket.empty()) take(lastBucket.front(), resultCallback);
+  m_bucket.clear();
+  m_nextBucket.clear();
+
+  if(!m_points->empty()) {
+    const TimePoint bufferTimePoint = m_points->front().timePoint;
+    resultCallback(m_points, bufferTimePoint);
+    m_points = pooledPoints();
+  }
+}
+
+template<typename V>
+using LttbProcessorBufferedMilliSecond =
+  LttbProcessorBuffered<V, MilliSecond>;
+
 template<typename T>
 class ValueDecimateFilter {
  public:
@@ -996,10 +1772,12 @@ class ValueDecimateFilter {
   Value m_lastValue{0};
 };
 
-template<typename V>
+template<typename V, typename TU = void>
 class TimeWindowRangeTracker {
  public:
   using Value = V;
+  using TimePoint = TimePointOf<TU>;
+  using Duration = DurationOf<TU>;
 
   struct Range {
     Value min;
@@ -1023,8 +1801,8 @@ class TimeWindowRangeTracker {
     return m_range;
   }
 
-  using CrossedRangeFunction = std::function<
-    void(Value crossingValue, double crossingTimePoint)
+  using CrossedRangeFunction = RH_InplaceFunction<
+    void(Value crossingValue, TimePoint crossingTimePoint)
   >;
 
   CrossedRangeFunction wentOutOfRange;
@@ -1038,35 +1816,55 @@ class TimeWindowRangeTracker {
     return !inRange();
   }
 
- protected:
-  void inRangeTimeWindow(double value) {
+  void inRangeTimeWindow(Duration value) {
     m_inRangeTimeWindow = value;
   }
 
-  double inRangeTimeWindow() {
-    return m_inRangeTimeWindow;
+  template<typename U = TU>
+  DurationOf<U> inRangeTimeWindow() {
+    return durationCast<U, TU>(m_inRangeTimeWindow);
   }
 
-  void outOfRangeTimeWindow(double value) {
+  void outOfRangeTimeWindow(Duration value) {
     m_outOfRangeTimeWindow = value;
   }
 
-  double outOfRangeTimeWindow() {
-    return m_outOfRangeTimeWindow;
+  template<typename U = TU>
+  DurationOf<U> outOfRangeTimeWindow() {
+    return durationCast<U, TU>(m_outOfRangeTimeWindow);
+  }
+
+  template<typename U = TU>
+  DurationOf<U> inRangeDuration() {
+    return durationCast<U, TU>(m_inRangeDuration);
   }
 
-  double inRangeDuration() {
-    return m_inRangeDuration;
+  template<typename U = TU>
+  DurationOf<U> outOfRangeDuration() {
+    return durationCast<U, TU>(m_outOfRangeDuration);
   }
 
-  double outOfRangeDuration() {
-    return m_outOfRangeDuration;
+  // Time point after which the time window running now goes out of or
+  // into range, no time point when none is running; for a TimingWheel
+  // timer.
+  template<typename U = TU>
+  TimePointOf<U> expiryTimePoint() const {
+    if(m_outOfRangeTrackerRunning) {
+      return timePointCast<U, TU>(
+        m_wentOutOfRangeTimePoint + m_outOfRangeTimeWindow);
+    }
+    if(m_inRangeTrackerRunning) {
+      return timePointCast<U, TU>(
+        m_wentIntoRangeTimePoint + m_inRangeTimeWindow);
+    }
+    return TimeUnitTraits<U>::noTimePoint();
   }
 
+ protected:
   TimeWindowRangeTracker(
     const Range& range,
-    double inRangeTimeWindow,
-    double outOfRangeTimeWindow
+    Duration inRangeTimeWindow,
+    Duration outOfRangeTimeWindow
   )
       : m_range(range),
         m_outOfRangeTimeWindow(outOfRangeTimeWindow),
@@ -1076,8 +1874,8 @@ class TimeWindowRangeTracker {
   TimeWindowRangeTracker(
     Value min,
     Value max,
-    double inRangeTimeWindow,
-    double outOfRangeTimeWindow
+    Duration inRangeTimeWindow,
+    Duration outOfRangeTimeWindow
   )
       : m_range(min, max),
         m_outOfRangeTimeWindow(outOfRangeTimeWindow),
@@ -1103,37 +1901,24 @@ class TimeWindowRangeTracker {
   //       parent class. We may still switch to CRTP in future for better
   //       run-time performance.
   void process(
-    std::function<Value(size_t)> dataSampleGetter,
-    std::function<double(size_t)> timePointGetter,
+    RH_FunctionRef<Value(size_t)> dataSampleGetter,
+    RH_FunctionRef<TimePoint(size_t)> timePointGetter,
     size_t samplesToProcess
-  ) {
-    for(size_t i = 0; i < samplesToProcess; ++i) {
-      Value sample = dataSampleGetter(i);
-      double timePoint = timePointGetter(i);
-      if(checkInRange(sample)) {
-        outOfRangeTrackerStop();
-        if(inRangeTrackerRunning()) inRangeTrackerUpdate(timePoint);
-        else {
-          if(!m_inRange) inRangeTrackerStart(sample, timePoint);
-          else inRangeTrackerUpdate(timePoint);
-        }
-      }
-      else {
-        inRangeTrackerStop();
-        if(outOfRangeTrackerRunning()) outOfRangeTrackerUpdate(timePoint);
-        else {
-          if(m_inRange) outOfRangeTrackerStart(sample, timePoint);
-          else outOfRangeTrackerUpdate(timePoint);
-        }
-      }
-    }
+  );
+
+  // Updates the time window running as a sample on the same side of the
+  // range at timePoint would; when no sample came since
+  // expiryTimePoint(), from a TimingWheel timer.
+  void expire(TimePoint timePoint) {
+    if(outOfRangeTrackerRunning()) outOfRangeTrackerUpdate(timePoint);
+    else if(inRangeTrackerRunning()) inRangeTrackerUpdate(timePoint);
   }
 
-  void outOfRangeTrackerStart(Value value, double timePoint) {
+  void outOfRangeTrackerStart(Value value, TimePoint timePoint) {
     m_wentOutOfRangeValue = value;
     m_wentOutOfRangeTimePoint = timePoint;
-    m_outOfRangeDuration = 0;
-    if(m_inRangeTimeWindow > 0) {
+    m_outOfRangeDuration = Duration{};
+    if(m_inRangeTimeWindow > Duration{}) {
       m_outOfRangeTrackerRunning = true;
     }
     else {
@@ -1149,7 +1934,7 @@ class TimeWindowRangeTracker {
     m_outOfRangeTrackerRunning = false;
   }
 
-  void outOfRangeTrackerUpdate(double timePoint) {
+  void outOfRangeTrackerUpdate(TimePoint timePoint) {
     m_outOfRangeDuration =
       timePoint - m_wentOutOfRangeTimePoint;
     if(m_outOfRangeDuration >
@@ -1169,11 +1954,11 @@ class TimeWindowRangeTracker {
     return m_outOfRangeTrackerRunning;
   }
 
-  void inRangeTrackerStart(Value value, double timePointMilliSecond) {
+  void inRangeTrackerStart(Value value, TimePoint timePoint) {
     m_wentIntoRangeValue = value;
-    m_wentIntoRangeTimePoint = timePointMilliSecond;
-    m_inRangeDuration = 0;
-    if(m_inRangeTimeWindow > 0) {
+    m_wentIntoRangeTimePoint = timePoint;
+    m_inRangeDuration = Duration{};
+    if(m_inRangeTimeWindow > Duration{}) {
       m_inRangeTrackerRunning = true;
     }
     else {
@@ -1189,9 +1974,9 @@ class TimeWindowRangeTracker {
     m_inRangeTrackerRunning = false;
   }
 
-  void inRangeTrackerUpdate(double timePointMilliSecond) {
+  void inRangeTrackerUpdate(TimePoint timePoint) {
     m_inRangeDuration =
-      timePointMilliSecond - m_wentIntoRangeTimePoint;
+      timePoint - m_wentIntoRangeTimePoint;
     if(m_inRangeDuration >
        m_inRangeTimeWindow &&
        m_inRangeTrackerRunning)
@@ -1215,65 +2000,121 @@ class TimeWindowRangeTracker {
 
   Value m_wentOutOfRangeValue{0};
   bool m_outOfRangeTrackerRunning{false};
-  double m_wentOutOfRangeTimePoint{0};
-  double m_outOfRangeDuration{0};
-  double m_outOfRangeTimeWindow;
+  TimePoint m_wentOutOfRangeTimePoint{};
+  Duration m_outOfRangeDuration{};
+  Duration m_outOfRangeTimeWindow;
 
   Value m_wentIntoRangeValue{0};
   bool m_inRangeTrackerRunning{false};
-  double m_wentIntoRangeTimePoint{0};
-  double m_inRangeDuration{0};
-  double m_inRangeTimeWindow;
+  TimePoint m_wentIntoRangeTimePoint{};
+  Duration m_inRangeDuration{};
+  Duration m_inRangeTimeWindow;
 };
 
-template<typename V>
+template<typename V, typename TU>
+RH_INLINE void TimeWindowRangeTracker<V, TU>::process(
+  RH_FunctionRef<Value(size_t)> dataSampleGetter,
+  RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+  size_t samplesToProcess
+) {
+  RH_TRACE_SCOPE(samplesToProcess, 0);
+  RH_PROFILE_ZONE;
+  for(size_t i = 0; i < samplesToProcess; ++i) {
+    Value sample = dataSampleGetter(i);
+    TimePoint timePoint = timePointGetter(i);
+    if(checkInRange(sample)) {
+      outOfRangeTrackerStop();
+      if(inRangeTrackerRunning()) inRangeTrackerUpdate(timePoint);
+      else {
+        if(!m_inRange) inRangeTrackerStart(sample, timePoint);
+        else inRangeTrackerUpdate(timePoint);
+      }
+    }
+    else {
+      inRangeTrackerStop();
+      if(outOfRangeTrackerRunning()) outOfRangeTrackerUpdate(timePoint);
+      else {
+        if(m_inRange) outOfRangeTrackerStart(sample, timePoint);
+        else outOfRangeTrackerUpdate(timePoint);
+      }
+    }
+  }
+}
+
+template<typename V, typename TU = MilliSecond>
 class TimeWindowPredicateTracker {
  public:
   using Value = V;
+  using TimePoint = TimePointOf<TU>;
+  using Duration = DurationOf<TU>;
   enum class ChangeDirection {unchanged, falseTrue, trueFalse};
 
-  using ResultCallback = std::function<
-    void(ChangeDirection changeDirection, MilliSecond changeTimePoint)
+  using ResultCallback = RH_InplaceFunction<
+    void(ChangeDirection changeDirection, TimePoint changeTimePoint)
   >;
+  using ResultCallbackRef =
+    RH_FunctionRef<typename ResultCallback::Signature>;
 
   bool lastPredicateValue() const {
     return m_lastPredicateValue;
   }
 
   ChangeDirection lastPredicateValueChangeDirection() const {
-    return m_lastPredicateValueChangeTimePoint;
+    return m_lastPredicateValueChangeDirection;
   }
 
-  MilliSecond lastPredicateValueChangeTimePoint() const {
-    return m_lastPredicateValueChangeTimePoint;
+  template<typename U = TU>
+  TimePointOf<U> lastPredicateValueChangeTimePoint() const {
+    return timePointCast<U, TU>(m_lastPredicateValueChangeTimePoint);
   }
 
-  MilliSecond lastPredicateValueCheckTimePoint() const {
-    return m_lastPredicateValueCheckTimePoint;
+  template<typename U = TU>
+  TimePointOf<U> lastPredicateValueCheckTimePoint() const {
+    return timePointCast<U, TU>(m_lastPredicateValueCheckTimePoint);
   }
 
-  void falseTrueTimeWindow(MilliSecond value) {
+  void falseTrueTimeWindow(Duration value) {
     m_falseTrueTimeWindow = value;
     reset();
   }
 
-  MilliSecond falseTrueTimeWindow() const {
-    return m_falseTrueTimeWindow;
+  template<typename U = TU>
+  DurationOf<U> falseTrueTimeWindow() const {
+    return durationCast<U, TU>(m_falseTrueTimeWindow);
   }
 
-  void trueFalseTimeWindow(MilliSecond value) {
+  void trueFalseTimeWindow(Duration value) {
     m_trueFalseTimeWindow = value;
     reset();
   }
 
-  MilliSecond trueFalseTimeWindow() const {
-    return m_trueFalseTimeWindow;
+  template<typename U = TU>
+  DurationOf<U> trueFalseTimeWindow() const {
+    return durationCast<U, TU>(m_trueFalseTimeWindow);
+  }
+
+  // Time point after which the predicate value changes when the last
+  // sample checked keeps differing from it, no time point when none
+  // does; for a TimingWheel timer.
+  template<typename U = TU>
+  TimePointOf<U> expiryTimePoint() const {
+    if(m_lastCheckedPredicateValue != m_lastPredicateValue) {
+      if(m_falseTrueTrackerRunning) {
+        return timePointCast<U, TU>(
+          m_falseTrueTimePoint + m_falseTrueTimeWindow);
+      }
+      if(m_trueFalseTrackerRunning) {
+        return timePointCast<U, TU>(
+          m_trueFalseTimePoint + m_trueFalseTimeWindow);
+      }
+    }
+    return TimeUnitTraits<U>::noTimePoint();
   }
 
  protected:
   TimeWindowPredicateTracker(
-    MilliSecond falseTrueTimeWindow,
-    MilliSecond trueFalseTimeWindow,
+    Duration falseTrueTimeWindow,
+    Duration trueFalseTimeWindow,
     bool lastPredicateValueInitial
   )
       : m_falseTrueTimeWindow(falseTrueTimeWindow),
@@ -1284,8 +2125,8 @@ class TimeWindowPredicateTracker {
   }
 
   void set(
-    MilliSecond falseTrueTimeWindow,
-    MilliSecond trueFalseTimeWindow,
+    Duration falseTrueTimeWindow,
+    Duration trueFalseTimeWindow,
     bool lastPredicateValueInitial
   ) {
     m_falseTrueTimeWindow = falseTrueTimeWindow;
@@ -1295,57 +2136,43 @@ class TimeWindowPredicateTracker {
 
   void reset() {
     m_lastPredicateValue = m_lastPredicateValueInitial;
+    m_lastCheckedPredicateValue = m_lastPredicateValueInitial;
     m_lastPredicateValueChangeDirection = ChangeDirection::unchanged;
-    m_lastPredicateValueChangeTimePoint =
-      MilliSecond(-std::numeric_limits<MilliSecond::Value>::infinity());
-    m_lastPredicateValueCheckTimePoint =
-      MilliSecond(-std::numeric_limits<MilliSecond::Value>::infinity());
+    m_lastPredicateValueChangeTimePoint = TimeUnitTraits<TU>::minTimePoint();
+    m_lastPredicateValueCheckTimePoint = TimeUnitTraits<TU>::minTimePoint();
     m_falseTrueTrackerRunning = false;
     m_trueFalseTrackerRunning = false;
-    m_falseTrueTimePoint =
-      MilliSecond(-std::numeric_limits<MilliSecond::Value>::infinity());
-    m_trueFalseTimePoint =
-      MilliSecond(-std::numeric_limits<MilliSecond::Value>::infinity());
+    m_falseTrueTimePoint = TimeUnitTraits<TU>::minTimePoint();
+    m_trueFalseTimePoint = TimeUnitTraits<TU>::minTimePoint();
   }
 
   void process(
-    const std::function<bool(size_t)>& predicate,
-    const std::function<MilliSecond(size_t)>& timePointGetter,
+    RH_FunctionRef<bool(size_t)> predicate,
+    RH_FunctionRef<TimePoint(size_t)> timePointGetter,
     size_t samplesToProcess,
-    const ResultCallback& resultCallback
-  ) {
-    for(size_t i = 0; i < samplesToProcess; ++i) {
-      bool predicateValue = predicate(i);
-      auto timePoint = timePointGetter(i);
-      m_lastPredicateValueCheckTimePoint = timePoint;
-      if(m_lastPredicateValue) {
-        // trueFalse change
-        if(m_lastPredicateValue != predicateValue) {
-          falseTrueTrackerStop();
-          if(trueFalseTrackerRunning())
-            trueFalseTrackerUpdate(timePoint, resultCallback);
-          else trueFalseTrackerStart(timePoint, resultCallback);
-        }
-      }
-      else {
-        // falseTrue change
-        if(m_lastPredicateValue != predicateValue) {
-          trueFalseTrackerStop();
-          if(falseTrueTrackerRunning())
-            falseTrueTrackerUpdate(timePoint, resultCallback);
-          else falseTrueTrackerStart(timePoint, resultCallback);
-        }
-      }
+    ResultCallbackRef resultCallback
+  );
+
+  // Updates the time window running as a sample of the last predicate
+  // value checked at timePoint would; when no sample came since
+  // expiryTimePoint(), from a TimingWheel timer.
+  void expire(TimePoint timePoint, ResultCallbackRef resultCallback) {
+    if(m_lastCheckedPredicateValue == m_lastPredicateValue) return;
+    if(falseTrueTrackerRunning()) {
+      falseTrueTrackerUpdate(timePoint, resultCallback);
+    }
+    else if(trueFalseTrackerRunning()) {
+      trueFalseTrackerUpdate(timePoint, resultCallback);
     }
   }
 
  private:
   void falseTrueTrackerStart(
-    MilliSecond timePoint,
-    const ResultCallback& resultCallback
+    TimePoint timePoint,
+    ResultCallbackRef resultCallback
   ) {
     m_falseTrueTimePoint = timePoint;
-    if(*m_falseTrueTimeWindow > 0) {
+    if(m_falseTrueTimeWindow > Duration{}) {
       m_falseTrueTrackerRunning = true;
     }
     else {
@@ -1360,11 +2187,11 @@ class TimeWindowPredicateTracker {
   }
 
   void falseTrueTrackerUpdate(
-    MilliSecond timePoint,
-    const ResultCallback& resultCallback
+    TimePoint timePoint,
+    ResultCallbackRef resultCallback
   ) {
     if(m_falseTrueTrackerRunning &&
-       *timePoint - *m_falseTrueTimePoint > *m_falseTrueTimeWindow
+       timePoint - m_falseTrueTimePoint > m_falseTrueTimeWindow
     ) {
       falseTrueTrackerStop();
       m_lastPredicateValue = true;
@@ -1386,11 +2213,11 @@ class TimeWindowPredicateTracker {
   }
 
   void trueFalseTrackerStart(
-    MilliSecond timePoint,
-    const ResultCallback& resultCallback
+    TimePoint timePoint,
+    ResultCallbackRef resultCallback
   ) {
     m_trueFalseTimePoint = timePoint;
-    if(*m_trueFalseTimeWindow > 0) {
+    if(m_trueFalseTimeWindow > Duration{}) {
       m_trueFalseTrackerRunning = true;
     }
     else {
@@ -1405,11 +2232,11 @@ class TimeWindowPredicateTracker {
   }
 
   void trueFalseTrackerUpdate(
-    MilliSecond timePoint,
-    const ResultCallback& resultCallback
+    TimePoint timePoint,
+    ResultCallbackRef resultCallback
   ) {
     if(m_trueFalseTrackerRunning &&
-       *timePoint - *m_trueFalseTimePoint > *m_trueFalseTimeWindow
+       timePoint - m_trueFalseTimePoint > m_trueFalseTimeWindow
     ) {
       trueFalseTrackerStop();
       m_lastPredicateValue = false;
@@ -1430,30 +2257,69 @@ class TimeWindowPredicateTracker {
     m_trueFalseTrackerRunning = false;
   }
 
-  MilliSecond m_falseTrueTimeWindow;
-  MilliSecond m_trueFalseTimeWindow;
+  Duration m_falseTrueTimeWindow;
+  Duration m_trueFalseTimeWindow;
   bool m_lastPredicateValueInitial;
 
   bool m_lastPredicateValue;
+  bool m_lastCheckedPredicateValue;
   ChangeDirection m_lastPredicateValueChangeDirection;
-  MilliSecond m_lastPredicateValueChangeTimePoint;
-  MilliSecond m_lastPredicateValueCheckTimePoint;
+  TimePoint m_lastPredicateValueChangeTimePoint;
+  TimePoint m_lastPredicateValueCheckTimePoint;
   bool m_falseTrueTrackerRunning;
   bool m_trueFalseTrackerRunning;
-  MilliSecond m_falseTrueTimePoint;
-  MilliSecond m_trueFalseTimePoint;
+  TimePoint m_falseTrueTimePoint;
+  TimePoint m_trueFalseTimePoint;
 };
 
-template<typename V>
+template<typename V, typename TU>
+RH_INLINE void TimeWindowPredicateTracker<V, TU>::process(
+  RH_FunctionRef<bool(size_t)> predicate,
+  RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+  size_t samplesToProcess,
+  ResultCallbackRef resultCallback
+) {
+  RH_TRACE_SCOPE(samplesToProcess, 0);
+  RH_PROFILE_ZONE;
+  for(size_t i = 0; i < samplesToProcess; ++i) {
+    bool predicateValue = predicate(i);
+    auto timePoint = timePointGetter(i);
+    m_lastPredicateValueCheckTimePoint = timePoint;
+    m_lastCheckedPredicateValue = predicateValue;
+    if(m_lastPredicateValue) {
+      // trueFalse change
+      if(m_lastPredicateValue != predicateValue) {
+        falseTrueTrackerStop();
+        if(trueFalseTrackerRunning())
+          trueFalseTrackerUpdate(timePoint, resultCallback);
+        else trueFalseTrackerStart(timePoint, resultCallback);
+      }
+    }
+    else {
+      // falseTrue change
+      if(m_lastPredicateValue != predicateValue) {
+        trueFalseTrackerStop();
+        if(falseTrueTrackerRunning())
+          falseTrueTrackerUpdate(timePoint, resultCallback);
+        else falseTrueTrackerStart(timePoint, resultCallback);
+      }
+    }
+  }
+}
+
+template<typename V, typename TU = MilliSecond>
 class TimeWindowGreaterThanThresholdTracker
-    : public TimeWindowPredicateTracker<V>
+    : public TimeWindowPredicateTracker<V, TU>
 {
  private:
-  using Base = TimeWindowPredicateTracker<V>;
+  using Base = TimeWindowPredicateTracker<V, TU>;
 
  public:
   using Value = typename Base::Value;
+  using TimePoint = typename Base::TimePoint;
+  using Duration = typename Base::Duration;
   using ResultCallback = typename Base::ResultCallback;
+  using ResultCallbackRef = typename Base::ResultCallbackRef;
 
   void thresholdDelta(Value value) {
     m_thresholdDelta = value;
@@ -1466,8 +2332,8 @@ class TimeWindowGreaterThanThresholdTracker
 
  protected:
   TimeWindowGreaterThanThresholdTracker(
-    MilliSecond falseTrueTimeWindow,
-    MilliSecond trueFalseTimeWindow,
+    Duration falseTrueTimeWindow,
+    Duration trueFalseTimeWindow,
     bool lastPredicateValueInitial,
     Value thresholdDelta
   )
@@ -1478,8 +2344,8 @@ class TimeWindowGreaterThanThresholdTracker
   {}
 
   void set(
-    MilliSecond falseTrueTimeWindow,
-    MilliSecond trueFalseTimeWindow,
+    Duration falseTrueTimeWindow,
+    Duration trueFalseTimeWindow,
     bool lastPredicateValueInitial,
     Value thresholdDelta
   ) {
@@ -1490,94 +2356,100 @@ class TimeWindowGreaterThanThresholdTracker
   }
 
   void process(
-    const std::function<Value(size_t)>& dataSampleGetter,
-    const std::function<Value(size_t)>& thresholdSampleGetter,
-    const std::function<MilliSecond(size_t)>& timePointGetter,
+    RH_FunctionRef<Value(size_t)> dataSampleGetter,
+    RH_FunctionRef<Value(size_t)> thresholdSampleGetter,
+    RH_FunctionRef<TimePoint(size_t)> timePointGetter,
     size_t samplesToProcess,
-    const ResultCallback& resultCallback
-  ) {
-    for(size_t i = 0; i < samplesToProcess; ++i) {
-      Base::process(
-        [this, &dataSampleGetter, &thresholdSampleGetter](size_t index) {
-          return dataSampleGetter(index) >
-                 thresholdSampleGetter(index) + m_thresholdDelta;
-        }, timePointGetter, samplesToProcess, resultCallback);
-    }
-  }
+    ResultCallbackRef resultCallback
+  );
 
  private:
   Value m_thresholdDelta;
 };
 
-template<typename V>
-class TimeWindowRangeTrackerMilliSecond : public TimeWindowRangeTracker<V> {
- private:
-  using Base = TimeWindowRangeTracker<V>;
-
- public:
-  void inRangeTimeWindowMilliSecond(double value) {
-    Base::inRangeTimeWindow(value);
-  }
-
-  double inRangeTimeWindowMilliSecond() {
-    return Base::inRangeTimeWindow();
-  }
-
-  void outOfRangeTimeWindowMilliSecond(double value) {
-    Base::outOfRangeTimeWindow(value);
-  }
+template<typename V, typename TU>
+RH_INLINE void TimeWindowGreaterThanThresholdTracker<V, TU>::process(
+  RH_FunctionRef<Value(size_t)> dataSampleGetter,
+  RH_FunctionRef<Value(size_t)> thresholdSampleGetter,
+  RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+  size_t samplesToProcess,
+  ResultCallbackRef resultCallback
+) {
+  Base::process(
+    [this, &dataSampleGetter, &thresholdSampleGetter](size_t index) {
+      return dataSampleGetter(index) >
+             thresholdSampleGetter(index) + m_thresholdDelta;
+    }, timePointGetter, samplesToProcess, resultCallback);
+}
 
-  double outOfRangeTimeWindowMilliSecond() {
-    return Base::outOfRangeTimeWindow();
+template<typename V>
+using TimeWindowRangeTrackerMilliSecond =
+  TimeWindowRangeTracker<V, MilliSecond>;
+
+// Comparators of TimeCompareValueTracker: true when newValue wins over
+// winningValue. They must order the values they let win strictly and
+// weakly; the first of equally winning samples wins. NaN samples never
+// win against MaxCompare, MinCompare and AbsMaxCompare.
+struct MaxCompare {
+  template<typename V>
+  bool operator()(V winningValue, V newValue) const {
+    return winningValue < newValue;
   }
+};
 
-  double inRangeDurationMilliSecond() {
-    return Base::inRangeDuration();
+struct MinCompare {
+  template<typename V>
+  bool operator()(V winningValue, V newValue) const {
+    return newValue < winningValue;
   }
+};
 
-  double outOfRangeDurationMilliSecond() {
-    return Base::outOfRangeDuration();
+struct AbsMaxCompare {
+  template<typename V>
+  bool operator()(V winningValue, V newValue) const {
+    return std::abs(winningValue) < std::abs(newValue);
   }
-
- protected:
-  template<typename ...Ts>
-  TimeWindowRangeTrackerMilliSecond(Ts&&... params)
-      : Base(std::forward<Ts>(params)...)
-  {}
 };
 
-template<typename V>
+template<typename V, typename Compare, typename TU = MilliSecond>
 class TimeCompareValueTracker {
  public:
   using Value = V;
+  using TimePoint = TimePointOf<TU>;
+  using Duration = DurationOf<TU>;
 
   using ResultCallback =
-    std::function<
-      // TODO: this would need some more work, but
-      //       "MilliSecond::Value lastValueTimePointMilliSecond"
-      //       must be converted to "MilliSecond lastValueTimePoint".
-      void(Value lastValue, MilliSecond::Value lastValueTimePointMilliSecond)
-    >;
+    RH_InplaceFunction<void(Value lastValue, TimePoint lastValueTimePoint)>;
+  using ResultCallbackRef =
+    RH_FunctionRef<typename ResultCallback::Signature>;
 
   Value lastValue() const {
     return m_lastValue;
   }
 
-  MilliSecond lastValueTimePoint() const {
-    return m_lastValueTimePoint;
+  template<typename U = TU>
+  TimePointOf<U> lastValueTimePoint() const {
+    return timePointCast<U, TU>(m_lastValueTimePoint);
   }
 
   void reset() {
     m_lastValue = m_lastValueInitial;
-    m_lastValueTimePoint = MilliSecond{0};
+    m_lastValueTimePoint = TimePoint{};
     track();
   }
 
- protected:
-  using Compare = bool(*)(Value winningValue, Value newValue);
+  // Index of the first of samples that would win against winningValue,
+  // samplesCount if none would. The samples are reduced in independent
+  // lanes first, which the compiler vectorizes for an inlined Compare.
+  static size_t winnerIndex(
+    const Value* samples,
+    size_t samplesCount,
+    Value winningValue
+  );
 
+ protected:
   TimeCompareValueTracker(
-    MilliSecond timeDurationToProcess,
+    Duration timeDurationToProcess,
     Value lastValueInitial,
     Value winningValueInitial
   )
@@ -1589,70 +2461,172 @@ class TimeCompareValueTracker {
   }
 
   void process(
-    const std::function<Value(size_t)>& dataSampleGetter,
-    const std::function<MilliSecond(size_t)>& timePointGetter,
+    RH_FunctionRef<Value(size_t)> dataSampleGetter,
+    RH_FunctionRef<TimePoint(size_t)> timePointGetter,
     size_t samplesToProcess,
-    const ResultCallback& resultCallback,
-    const Compare& compare
-  ) {
-    for(size_t i = 0; i < samplesToProcess; ++i) {
-      auto dataSample = dataSampleGetter(i);
-      auto timePoint = timePointGetter(i);
-
-      if(std::isnan(*m_timePointWhenTrackingStarted)) {
-        m_timePointWhenTrackingStarted = timePoint;
-      }
+    ResultCallbackRef resultCallback
+  );
 
-      if(compare(m_currentWinningValue, dataSample)) {
-        m_currentWinningValue = dataSample;
-        m_currentWinningValueTimePoint = timePoint;
-      }
-
-      MilliSecond timeDuration{
-        std::abs(*timePoint - *m_timePointWhenTrackingStarted)};
-      if(*m_timeDurationToProcess < *timeDuration) {
-        m_lastValue = m_currentWinningValue;
-        m_lastValueTimePoint = m_currentWinningValueTimePoint;
-        track();
-
-        resultCallback(m_lastValue, *m_lastValueTimePoint);
-      }
-    }
-  }
+  // Same as above for samples and time points in arrays: the winner of
+  // each time window is found by winnerIndex() over the whole window.
+  void process(
+    const Value* samples,
+    const TimePoint* timePoints,
+    size_t samplesToProcess,
+    ResultCallbackRef resultCallback
+  );
 
   void track() {
     m_currentWinningValue = m_winningValueInitial;
-    m_currentWinningValueTimePoint =
-      MilliSecond{std::numeric_limits<MilliSecond::Value>::quiet_NaN()};
-    m_timePointWhenTrackingStarted =
-      MilliSecond{std::numeric_limits<MilliSecond::Value>::quiet_NaN()};
+    m_currentWinningValueTimePoint = TimeUnitTraits<TU>::noTimePoint();
+    m_timePointWhenTrackingStarted = TimeUnitTraits<TU>::noTimePoint();
   }
 
  private:
-  const MilliSecond m_timeDurationToProcess;
+  bool timeDurationExceeded(TimePoint timePoint) const {
+    return m_timeDurationToProcess <
+      timeDistance(timePoint, m_timePointWhenTrackingStarted);
+  }
+
+  void lastValueUpdate(ResultCallbackRef resultCallback) {
+    m_lastValue = m_currentWinningValue;
+    m_lastValueTimePoint = m_currentWinningValueTimePoint;
+    track();
+
+    resultCallback(m_lastValue, m_lastValueTimePoint);
+  }
+
+  const Duration m_timeDurationToProcess;
   const Value m_lastValueInitial;
   const Value m_winningValueInitial;
 
   Value m_currentWinningValue;
-  MilliSecond m_currentWinningValueTimePoint;
-  MilliSecond m_timePointWhenTrackingStarted;
+  TimePoint m_currentWinningValueTimePoint;
+  TimePoint m_timePointWhenTrackingStarted;
 
   Value m_lastValue;
-  MilliSecond m_lastValueTimePoint;
+  TimePoint m_lastValueTimePoint;
 };
 
-template<typename V>
-class TimeMaxValueTracker : public TimeCompareValueTracker<V> {
+template<typename V, typename Compare, typename TU>
+RH_INLINE size_t TimeCompareValueTracker<V, Compare, TU>::winnerIndex(
+  const Value* samples,
+  size_t samplesCount,
+  Value winningValue
+) {
+  const Compare compare;
+  constexpr size_t lanesCount =
+    sizeof(Value) < 64 ? 64 / sizeof(Value) : 1;
+  Value laneWinningValues[lanesCount];
+  for(size_t lane = 0; lane < lanesCount; ++lane) {
+    laneWinningValues[lane] = winningValue;
+  }
+  size_t i = 0;
+  for(; i + lanesCount <= samplesCount; i += lanesCount) {
+    for(size_t lane = 0; lane < lanesCount; ++lane) {
+      const Value sample = samples[i + lane];
+      laneWinningValues[lane] =
+        compare(laneWinningValues[lane], sample)
+        ? sample : laneWinningValues[lane];
+    }
+  }
+  Value winner = winningValue;
+  for(size_t lane = 0; lane < lanesCount; ++lane) {
+    if(compare(winner, laneWinningValues[lane])) {
+      winner = laneWinningValues[lane];
+    }
+  }
+  for(; i < samplesCount; ++i) {
+    if(compare(winner, samples[i])) winner = samples[i];
+  }
+  if(!compare(winningValue, winner)) return samplesCount;
+
+  // First sample winning against winningValue that winner does not beat.
+  for(i = 0; i < samplesCount; ++i) {
+    if(compare(winningValue, samples[i]) && !compare(samples[i], winner)) {
+      break;
+    }
+  }
+  return i;
+}
+
+template<typename V, typename Compare, typename TU>
+RH_INLINE void TimeCompareValueTracker<V, Compare, TU>::process(
+  RH_FunctionRef<Value(size_t)> dataSampleGetter,
+  RH_FunctionRef<TimePoint(size_t)> timePointGetter,
+  size_t samplesToProcess,
+  ResultCallbackRef resultCallback
+) {
+  RH_TRACE_SCOPE(samplesToProcess, 0);
+  RH_PROFILE_ZONE;
+  const Compare compare;
+  for(size_t i = 0; i < samplesToProcess; ++i) {
+    auto dataSample = dataSampleGetter(i);
+    auto timePoint = timePointGetter(i);
+
+    if(!TimeUnitTraits<TU>::isTimePoint(m_timePointWhenTrackingStarted)) {
+      m_timePointWhenTrackingStarted = timePoint;
+    }
+
+    if(compare(m_currentWinningValue, dataSample)) {
+      m_currentWinningValue = dataSample;
+      m_currentWinningValueTimePoint = timePoint;
+    }
+
+    if(timeDurationExceeded(timePoint)) lastValueUpdate(resultCallback);
+  }
+}
+
+template<typename V, typename Compare, typename TU>
+RH_INLINE void TimeCompareValueTracker<V, Compare, TU>::process(
+  const Value* samples,
+  const TimePoint* timePoints,
+  size_t samplesToProcess,
+  ResultCallbackRef resultCallback
+) {
+  RH_TRACE_SCOPE(samplesToProcess, 0);
+  RH_PROFILE_ZONE;
+  for(size_t i = 0; i < samplesToProcess;) {
+    if(!TimeUnitTraits<TU>::isTimePoint(m_timePointWhenTrackingStarted)) {
+      m_timePointWhenTrackingStarted = timePoints[i];
+    }
+
+    // The window ends with its first sample past the duration.
+    size_t windowEnd = i;
+    while(windowEnd < samplesToProcess &&
+          !timeDurationExceeded(timePoints[windowEnd])) {
+      ++windowEnd;
+    }
+    const bool windowEnded = windowEnd < samplesToProcess;
+    if(windowEnded) ++windowEnd;
+
+    const size_t winner =
+      i + winnerIndex(samples + i, windowEnd - i, m_currentWinningValue);
+    if(winner < windowEnd) {
+      m_currentWinningValue = samples[winner];
+      m_currentWinningValueTimePoint = timePoints[winner];
+    }
+
+    if(windowEnded) lastValueUpdate(resultCallback);
+    i = windowEnd;
+  }
+}
+
+template<typename V, typename TU = MilliSecond>
+class TimeMaxValueTracker : public TimeCompareValueTracker<V, MaxCompare, TU> {
  private:
-  using Base = TimeCompareValueTracker<V>;
+  using Base = TimeCompareValueTracker<V, MaxCompare, TU>;
 
  public:
   using Value = typename Base::Value;
+  using TimePoint = typename Base::TimePoint;
+  using Duration = typename Base::Duration;
   using ResultCallback = typename Base::ResultCallback;
+  using ResultCallbackRef = typename Base::ResultCallbackRef;
 
  protected:
   TimeMaxValueTracker(
-    MilliSecond timeDurationToProcess,
+    Duration timeDurationToProcess,
     Value lastValueInitial
   )
       : Base{
@@ -1660,35 +2634,23 @@ class TimeMaxValueTracker : public TimeCompareValueTracker<V> {
           lastValueInitial,
           std::numeric_limits<Value>::lowest()}
   {}
-
-  void process(
-    const std::function<Value(size_t)>& dataSampleGetter,
-    const std::function<MilliSecond(size_t)>& timePointGetter,
-    size_t samplesToProcess,
-    const ResultCallback& resultCallback
-  ) {
-    Base::process(
-      dataSampleGetter, timePointGetter,
-      samplesToProcess, resultCallback,
-      [](Value winningValue, Value newValue) {
-        return winningValue < newValue;
-      }
-    );
-  }
 };
 
-template<typename V>
-class TimeMinValueTracker : public TimeCompareValueTracker<V> {
+template<typename V, typename TU = MilliSecond>
+class TimeMinValueTracker : public TimeCompareValueTracker<V, MinCompare, TU> {
  private:
-  using Base = TimeCompareValueTracker<V>;
+  using Base = TimeCompareValueTracker<V, MinCompare, TU>;
 
  public:
   using Value = typename Base::Value;
+  using TimePoint = typename Base::TimePoint;
+  using Duration = typename Base::Duration;
   using ResultCallback = typename Base::ResultCallback;
+  using ResultCallbackRef = typename Base::ResultCallbackRef;
 
  protected:
   TimeMinValueTracker(
-    MilliSecond timeDurationToProcess,
+    Duration timeDurationToProcess,
     Value lastValueInitial
   )
       : Base{
@@ -1696,23 +2658,59 @@ class TimeMinValueTracker : public TimeCompareValueTracker<V> {
           lastValueInitial,
           std::numeric_limits<Value>::max()}
   {}
-
-  void process(
-    const std::function<Value(size_t)>& dataSampleGetter,
-    const std::function<MilliSecond(size_t)>& timePointGetter,
-    size_t samplesToProcess,
-    const ResultCallback& resultCallback
-  ) {
-    Base::process(
-      dataSampleGetter, timePointGetter,
-      samplesToProcess, resultCallback,
-      [](Value winningValue, Value newValue) {
-        return winningValue > newValue;
-      }
-    );
-  }
 };
 
+// Processors of the common sample types are instantiated once, in
+// SignalProcessors.cpp of //signal_processors:lib, unless RH_USE_INLINE
+// is defined (header only //signal_processors). Other sample types are
+// instantiated where used either way.
+#define RH__SIGNAL_PROCESSORS_INSTANTIATE(EXTERN, V)                    \
+  EXTERN template class Buffered<V>;                                    \
+  EXTERN template class ChangeTrackerUnitlessBase<V>;                   \
+  EXTERN template class ChangeTrackerBase<V, void>;                     \
+  EXTERN template class ChangeTrackerBase<V, Second>;                   \
+  EXTERN template class ChangeTrackerBase<V, MilliSecond>;              \
+  EXTERN template class ChangeTracker<V, Second>;                       \
+  EXTERN template class ChangeTracker<V, MilliSecond>;                  \
+  EXTERN template class ChangeTrackerForceUpdated<V, Second>;           \
+  EXTERN template class ChangeTrackerForceUpdated<V, MilliSecond>;      \
+  EXTERN template class DeadbandTracker<V, Second>;                     \
+  EXTERN template class DeadbandTracker<V, MilliSecond>;                \
+  EXTERN template class SwingingDoorTracker<V, Second>;                 \
+  EXTERN template class SwingingDoorTracker<V, MilliSecond>;            \
+  EXTERN template class TimeWindowPeakToPeakTracker<V, void>;           \
+  EXTERN template class TimeWindowPeakToPeakTracker<V, Second>;         \
+  EXTERN template class TimeAccumulateProcessorUnitlessBase<V>;         \
+  EXTERN template class TimeAccumulateProcessorBase<V, Second>;         \
+  EXTERN template class TimeAccumulateProcessorBase<V, MilliSecond>;    \
+  EXTERN template class TimeAccumulateProcessor<V, Second>;             \
+  EXTERN template class TimeAccumulateProcessor<V, MilliSecond>;        \
+  EXTERN template class TimeAverager<V, Second>;                        \
+  EXTERN template class TimeAverager<V, MilliSecond>;                   \
+  EXTERN template class TimeRmseProcessor<V, Second>;                   \
+  EXTERN template class TimeSdProcessor<V, Second>;                     \
+  EXTERN template class ForwardProcessorBuffered<V, void>;              \
+  EXTERN template class ForwardProcessorBuffered<V, MilliSecond>;       \
+  EXTERN template class TimeAveragerBuffered<V, MilliSecond>;           \
+  EXTERN template class LttbProcessorBuffered<V, void>;                 \
+  EXTERN template class LttbProcessorBuffered<V, MilliSecond>;          \
+  EXTERN template class ValueDecimateFilter<V>;                         \
+  EXTERN template class TimeWindowRangeTracker<V, void>;                \
+  EXTERN template class TimeWindowRangeTracker<V, MilliSecond>;         \
+  EXTERN template class TimeWindowPredicateTracker<V, MilliSecond>;     \
+  EXTERN template class TimeWindowGreaterThanThresholdTracker<V, MilliSecond>;\
+  EXTERN template class TimeCompareValueTracker<V, MaxCompare, MilliSecond>; \
+  EXTERN template class TimeCompareValueTracker<V, MinCompare, MilliSecond>; \
+  EXTERN template class TimeMaxValueTracker<V, MilliSecond>;            \
+  EXTERN template class TimeMinValueTracker<V, MilliSecond>;
+
+#ifndef RH_USE_INLINE
+RH__SIGNAL_PROCESSORS_INSTANTIATE(extern, double)
+RH__SIGNAL_PROCESSORS_INSTANTIATE(extern, float)
+RH__SIGNAL_PROCESSORS_INSTANTIATE(extern, int32_t)
+RH__SIGNAL_PROCESSORS_INSTANTIATE(extern, int16_t)
+#endif // RH_USE_INLINE
+
 } // namespace signal_processors
 
 } // namespace rh
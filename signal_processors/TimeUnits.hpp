@@ -0,0 +1,270 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+#ifndef __TimeUnits_hpp__
+#define __TimeUnits_hpp__
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+
+namespace rh {
+
+namespace signal_processors {
+
+// Time units of the processors' TU parameter. A processor is written once
+// against TimePointOf<TU> and DurationOf<TU> and is instantiated per unit:
+//
+//   void         double, no unit (the caller's)
+//   Second       double seconds
+//   MilliSecond  double milliseconds
+//   Ticks<P>     int64 ticks of P seconds, see below
+//
+// Conversions between units (timePointCast, durationCast) scale by a
+// factor fixed at compile time from the units' std::ratio periods.
+
+class Second {
+ public:
+  using Period = std::ratio<1>;
+};
+
+class MilliSecond {
+ private:
+  using Self = MilliSecond;
+
+ public:
+  using Period = std::milli;
+  using Value = double;
+
+  MilliSecond() =default;
+
+  MilliSecond(const Self& other)
+      : m_value{other.m_value}
+  {}
+
+  explicit MilliSecond(Value value)
+      : m_value{value}
+  {}
+
+  Value value() const {
+    return m_value;
+  }
+
+  Value& operator *() {
+    return m_value;
+  }
+
+  const Value& operator *() const {
+    return m_value;
+  }
+
+ private:
+  Value m_value{};
+};
+
+// Time unit of whole int64 ticks of Period seconds:
+//
+//   ChangeTracker<double, MicroSecondTicks>
+//
+// Time points and durations are std::chrono types of that tick, so window
+// checks are integer compares, precision does not drop as time points
+// grow (2^63 µs is about 290000 years) and units mixed up by mistake do
+// not compile. Epoch is whatever the data source counts from.
+template<typename P>
+class Ticks {
+ public:
+  using Period = P;
+  using Rep = int64_t;
+  using Duration = std::chrono::duration<Rep, Period>;
+  using TimePoint = std::chrono::time_point<Ticks, Duration>;
+
+  // Conversions from and to the double (milli)seconds the rest of the
+  // signal processing uses, rounded to the nearest tick.
+  static constexpr Duration fromSecond(double value) {
+    return std::chrono::round<Duration>(
+      std::chrono::duration<double>(value));
+  }
+
+  static constexpr Duration fromMilliSecond(double value) {
+    return std::chrono::round<Duration>(
+      std::chrono::duration<double, std::milli>(value));
+  }
+
+  static constexpr TimePoint timePointFromSecond(double value) {
+    return TimePoint(fromSecond(value));
+  }
+
+  static constexpr TimePoint timePointFromMilliSecond(double value) {
+    return TimePoint(fromMilliSecond(value));
+  }
+
+  static constexpr double toSecond(Duration value) {
+    return std::chrono::duration<double>(value).count();
+  }
+
+  static constexpr double toMilliSecond(Duration value) {
+    return std::chrono::duration<double, std::milli>(value).count();
+  }
+
+  static constexpr double toSecond(TimePoint value) {
+    return toSecond(value.time_since_epoch());
+  }
+
+  static constexpr double toMilliSecond(TimePoint value) {
+    return toMilliSecond(value.time_since_epoch());
+  }
+};
+
+using NanoSecondTicks = Ticks<std::nano>;
+using MicroSecondTicks = Ticks<std::micro>;
+using MilliSecondTicks = Ticks<std::milli>;
+
+// Time point and duration types of a TU and their conversions from and to
+// std::chrono durations. noTimePoint() marks a time point not set yet,
+// minTimePoint() one before all others.
+template<typename TU>
+struct TimeUnitTraits {
+  using TimePoint = double;
+  using Duration = double;
+  using ChronoDuration = std::chrono::duration<double, typename TU::Period>;
+
+  static constexpr ChronoDuration chronoDuration(Duration value) {
+    return ChronoDuration(value);
+  }
+
+  template<typename R, typename P>
+  static constexpr Duration duration(std::chrono::duration<R, P> value) {
+    return std::chrono::duration_cast<ChronoDuration>(value).count();
+  }
+
+  static constexpr Duration sinceEpoch(TimePoint value) {
+    return value;
+  }
+
+  static constexpr TimePoint timePoint(Duration sinceEpoch) {
+    return sinceEpoch;
+  }
+
+  static constexpr TimePoint noTimePoint() {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  static bool isTimePoint(TimePoint value) {
+    return !std::isnan(value);
+  }
+
+  static constexpr TimePoint minTimePoint() {
+    return -std::numeric_limits<double>::infinity();
+  }
+};
+
+template<>
+struct TimeUnitTraits<void> {
+  using TimePoint = double;
+  using Duration = double;
+
+  static constexpr TimePoint noTimePoint() {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  static bool isTimePoint(TimePoint value) {
+    return !std::isnan(value);
+  }
+
+  static constexpr TimePoint minTimePoint() {
+    return -std::numeric_limits<double>::infinity();
+  }
+};
+
+template<typename P>
+struct TimeUnitTraits<Ticks<P>> {
+  using TimePoint = typename Ticks<P>::TimePoint;
+  using Duration = typename Ticks<P>::Duration;
+  using ChronoDuration = Duration;
+
+  static constexpr ChronoDuration chronoDuration(Duration value) {
+    return value;
+  }
+
+  template<typename R, typename Q>
+  static constexpr Duration duration(std::chrono::duration<R, Q> value) {
+    return std::chrono::round<Duration>(value);
+  }
+
+  static constexpr Duration sinceEpoch(TimePoint value) {
+    return value.time_since_epoch();
+  }
+
+  static constexpr TimePoint timePoint(Duration sinceEpoch) {
+    return TimePoint(sinceEpoch);
+  }
+
+  static constexpr TimePoint noTimePoint() {
+    return TimePoint::min();
+  }
+
+  static constexpr bool isTimePoint(TimePoint value) {
+    return value != TimePoint::min();
+  }
+
+  static constexpr TimePoint minTimePoint() {
+    return TimePoint::min();
+  }
+};
+
+template<typename TU>
+using TimePointOf = typename TimeUnitTraits<TU>::TimePoint;
+
+template<typename TU>
+using DurationOf = typename TimeUnitTraits<TU>::Duration;
+
+// Duration or time point of FromTU in ToTU; the same value when the units
+// are the same, rounded to the nearest tick for Ticks. void converts only
+// to itself.
+template<typename ToTU, typename FromTU>
+constexpr DurationOf<ToTU> durationCast(DurationOf<FromTU> value) {
+  if constexpr(std::is_same_v<ToTU, FromTU>) return value;
+  else {
+    return TimeUnitTraits<ToTU>::duration(
+      TimeUnitTraits<FromTU>::chronoDuration(value));
+  }
+}
+
+template<typename ToTU, typename FromTU>
+constexpr TimePointOf<ToTU> timePointCast(TimePointOf<FromTU> value) {
+  if constexpr(std::is_same_v<ToTU, FromTU>) return value;
+  else {
+    return TimeUnitTraits<ToTU>::timePoint(
+      durationCast<ToTU, FromTU>(TimeUnitTraits<FromTU>::sinceEpoch(value)));
+  }
+}
+
+// Absolute time between two time points.
+inline double timeDistance(double timePoint, double otherTimePoint) {
+  return std::abs(timePoint - otherTimePoint);
+}
+
+template<typename C, typename D>
+constexpr D timeDistance(std::chrono::time_point<C, D> timePoint,
+                         std::chrono::time_point<C, D> otherTimePoint) {
+  return timePoint < otherTimePoint
+    ? otherTimePoint - timePoint
+    : timePoint - otherTimePoint;
+}
+
+// Duration in its unit as double, for rates like value per unit.
+inline double durationCount(double duration) {
+  return duration;
+}
+
+template<typename R, typename P>
+constexpr double durationCount(std::chrono::duration<R, P> duration) {
+  return static_cast<double>(duration.count());
+}
+
+} // namespace signal_processors
+
+} // namespace rh
+
+#endif // __TimeUnits_hpp__
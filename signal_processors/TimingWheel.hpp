@@ -0,0 +1,329 @@
+// Hey Emacs, this is -*- coding: utf-8; mode: c++ -*-
+#ifndef __TimingWheel_hpp__
+#define __TimingWheel_hpp__
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "debug/RH_PROFILE.hpp"
+#include "debug/RH_TRACE.hpp"
+#include "function/RH_FUNCTION.hpp"
+
+#include "TimeUnits.hpp"
+
+namespace rh {
+
+namespace signal_processors {
+
+// Hierarchical timing wheel, shared by the processors of many channels so
+// that their time windows expire when no sample comes (see their
+// expiryTimePoint() and expire()). Timers are scheduled and cancelled in
+// O(1) and fire at the first tick after their deadline, when advance()
+// passes it: on the thread calling it, e.g. the clock thread of start().
+//
+// 4 levels of 64 slots cover 2^24 ticks, 46 hours of 10 ms ticks; level k
+// slots are 64^k ticks wide and their timers move to lower levels when
+// the wheel reaches them. Timers further out wait in the last level.
+//
+// Processors are not thread safe, so a callback serializes with the
+// owner's process() calls, e.g. by the lock they take:
+//
+//   TimingWheel<MilliSecond>::Timer m_timer{wheel,
+//     [this](double now) {
+//       std::lock_guard<std::mutex> lock(m_mutex);
+//       expire(now, m_resultCallback);
+//       m_timer.schedule(expiryTimePoint());
+//     }};
+//   ...
+//   process(...);
+//   m_timer.schedule(expiryTimePoint());
+template<typename TU = MilliSecond>
+class TimingWheel {
+ public:
+  using TimePoint = TimePointOf<TU>;
+  using Duration = DurationOf<TU>;
+  using Callback = RH_InplaceFunction<void(TimePoint now)>;
+  using NowFunction = RH_InplaceFunction<TimePoint()>;
+
+  class Timer {
+   public:
+    Timer(TimingWheel& wheel, Callback callback)
+        : m_wheel(wheel),
+          m_callback(std::move(callback))
+    {}
+
+    // Waits for the callback to return when it is running on another
+    // thread, so the owner must not hold a lock the callback takes; a
+    // schedule() by that callback is undone.
+    ~Timer();
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+    // Fires the callback once, at the first tick after deadline, instead
+    // of when scheduled before. No time point cancels it.
+    void schedule(TimePoint deadline);
+
+    // A callback already running still returns.
+    void cancel();
+
+    bool scheduled() const;
+
+   private:
+    friend class TimingWheel;
+
+    enum class State {idle, scheduled, firing};
+
+    TimingWheel& m_wheel;
+    Callback m_callback;
+
+    // Under the wheel's m_mutex.
+    State m_state = State::idle;
+    uint64_t m_tick = 0;
+    unsigned m_slot = 0;
+    Timer* m_previous = nullptr;
+    Timer* m_next = nullptr;
+  };
+
+  TimingWheel(Duration tickDuration, TimePoint startTimePoint)
+      : m_tickDuration{tickDuration},
+        m_startTimePoint{startTimePoint}
+  {}
+
+  ~TimingWheel() {
+    stop();
+  }
+
+  TimingWheel(const TimingWheel&) = delete;
+  TimingWheel& operator=(const TimingWheel&) = delete;
+
+  template<typename U = TU>
+  DurationOf<U> tickDuration() const {
+    return durationCast<U, TU>(m_tickDuration);
+  }
+
+  // Fires the timers due up to now. From one thread at a time.
+  void advance(TimePoint now);
+
+  // Calls advance(now()) every tick on a thread of its own until stop().
+  void start(NowFunction now);
+
+  void stop();
+
+  size_t timersCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_timersCount;
+  }
+
+ private:
+  static constexpr unsigned slotBits = 6;
+  static constexpr unsigned slotsCount = 1u << slotBits;
+  static constexpr unsigned levelsCount = 4;
+  static constexpr uint64_t ticksCount =
+    uint64_t(1) << (slotBits * levelsCount);
+
+  // First tick after timePoint.
+  uint64_t tickAfter(TimePoint timePoint) const {
+    const double ticks = durationCount(timePoint - m_startTimePoint) /
+                         durationCount(m_tickDuration);
+    if(!(ticks >= 0)) return 0;
+    if(ticks >= double(uint64_t(1) << 62)) return uint64_t(1) << 62;
+    return uint64_t(ticks) + 1;
+  }
+
+  // Last tick at or before timePoint.
+  uint64_t tickAt(TimePoint timePoint) const {
+    const uint64_t tick = tickAfter(timePoint);
+    return tick == 0 ? 0 : tick - 1;
+  }
+
+  // Under m_mutex. Timers due before minimumTick fire at minimumTick.
+  void link(Timer& timer, uint64_t minimumTick);
+  void unlink(Timer& timer);
+  void cascade(unsigned level);
+
+  const Duration m_tickDuration;
+  const TimePoint m_startTimePoint;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_condition;
+  Timer* m_slots[levelsCount * slotsCount] = {};
+  uint64_t m_currentTick = 0;
+  size_t m_timersCount = 0;
+
+  // Timers of the current tick and the one running its callback.
+  std::vector<Timer*> m_firing;
+  const Timer* m_running = nullptr;
+  std::thread::id m_runningThreadId;
+
+  std::thread m_thread;
+  bool m_stopped = false;
+};
+
+template<typename TU>
+inline TimingWheel<TU>::Timer::~Timer() {
+  std::unique_lock<std::mutex> lock(m_wheel.m_mutex);
+  if(m_state == State::scheduled) m_wheel.unlink(*this);
+  if(m_state == State::firing) {
+    std::replace(m_wheel.m_firing.begin(), m_wheel.m_firing.end(),
+                 this, static_cast<Timer*>(nullptr));
+  }
+  m_state = State::idle;
+  m_wheel.m_condition.wait(lock, [this] {
+    return m_wheel.m_running != this ||
+           m_wheel.m_runningThreadId == std::this_thread::get_id();
+  });
+  // The callback it waited for may have scheduled it again.
+  if(m_state == State::scheduled) m_wheel.unlink(*this);
+  m_state = State::idle;
+}
+
+template<typename TU>
+inline void TimingWheel<TU>::Timer::schedule(TimePoint deadline) {
+  if(!TimeUnitTraits<TU>::isTimePoint(deadline)) {
+    cancel();
+    return;
+  }
+  const uint64_t tick = m_wheel.tickAfter(deadline);
+  std::lock_guard<std::mutex> lock(m_wheel.m_mutex);
+  if(m_state == State::scheduled) m_wheel.unlink(*this);
+  m_tick = tick;
+  m_state = State::scheduled;
+  m_wheel.link(*this, m_wheel.m_currentTick + 1);
+  ++m_wheel.m_timersCount;
+}
+
+template<typename TU>
+inline void TimingWheel<TU>::Timer::cancel() {
+  std::lock_guard<std::mutex> lock(m_wheel.m_mutex);
+  if(m_state == State::scheduled) m_wheel.unlink(*this);
+  m_state = State::idle;
+}
+
+template<typename TU>
+inline bool TimingWheel<TU>::Timer::scheduled() const {
+  std::lock_guard<std::mutex> lock(m_wheel.m_mutex);
+  return m_state == State::scheduled;
+}
+
+template<typename TU>
+inline void TimingWheel<TU>::link(Timer& timer, uint64_t minimumTick) {
+  // Timers beyond the last level wait in it and are linked again when it
+  // cascades.
+  const uint64_t tick = std::min(std::max(timer.m_tick, minimumTick),
+                                 m_currentTick + ticksCount - 1);
+  const uint64_t delta = tick - m_currentTick;
+  unsigned level = 0;
+  while(level + 1 < levelsCount &&
+        delta >= uint64_t(1) << (slotBits * (level + 1))) {
+    ++level;
+  }
+  timer.m_slot = level * slotsCount +
+    ((tick >> (slotBits * level)) & (slotsCount - 1));
+  timer.m_previous = nullptr;
+  timer.m_next = m_slots[timer.m_slot];
+  if(timer.m_next) timer.m_next->m_previous = &timer;
+  m_slots[timer.m_slot] = &timer;
+}
+
+template<typename TU>
+inline void TimingWheel<TU>::unlink(Timer& timer) {
+  if(timer.m_previous) timer.m_previous->m_next = timer.m_next;
+  else m_slots[timer.m_slot] = timer.m_next;
+  if(timer.m_next) timer.m_next->m_previous = timer.m_previous;
+  timer.m_previous = timer.m_next = nullptr;
+  --m_timersCount;
+}
+
+template<typename TU>
+inline void TimingWheel<TU>::cascade(unsigned level) {
+  const unsigned slot = level * slotsCount +
+    ((m_currentTick >> (slotBits * level)) & (slotsCount - 1));
+  Timer* timer = m_slots[slot];
+  m_slots[slot] = nullptr;
+  while(timer) {
+    Timer* next = timer->m_next;
+    link(*timer, m_currentTick);
+    timer = next;
+  }
+}
+
+template<typename TU>
+inline void TimingWheel<TU>::advance(TimePoint now) {
+  RH_PROFILE_ZONE;
+  const uint64_t tick = tickAt(now);
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while(m_currentTick < tick) {
+    ++m_currentTick;
+    for(unsigned level = levelsCount - 1; level > 0; --level) {
+      const uint64_t mask = (uint64_t(1) << (slotBits * level)) - 1;
+      if((m_currentTick & mask) == 0) cascade(level);
+    }
+
+    Timer*& slot = m_slots[m_currentTick & (slotsCount - 1)];
+    for(Timer* timer = slot; timer; timer = timer->m_next) {
+      timer->m_state = Timer::State::firing;
+      m_firing.push_back(timer);
+      --m_timersCount;
+    }
+    slot = nullptr;
+    if(m_firing.empty()) continue;
+
+    RH_TRACE_SCOPE(m_firing.size(), 0);
+    m_runningThreadId = std::this_thread::get_id();
+    for(size_t i = 0; i < m_firing.size(); ++i) {
+      Timer* timer = m_firing[i];
+      if(!timer || timer->m_state != Timer::State::firing) continue;
+      timer->m_state = Timer::State::idle;
+      m_running = timer;
+      lock.unlock();
+      timer->m_callback(now);
+      lock.lock();
+      m_running = nullptr;
+      m_condition.notify_all();
+    }
+    m_firing.clear();
+  }
+}
+
+template<typename TU>
+inline void TimingWheel<TU>::start(NowFunction now) {
+  stop();
+  m_stopped = false;
+  m_thread = std::thread([this, now = std::move(now)] {
+    const auto tickDuration =
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        TimeUnitTraits<TU>::chronoDuration(m_tickDuration));
+    auto wakeTimePoint = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while(!m_stopped) {
+      wakeTimePoint += tickDuration;
+      if(m_condition.wait_until(lock, wakeTimePoint,
+                                [this] { return m_stopped; })) break;
+      lock.unlock();
+      advance(now());
+      lock.lock();
+    }
+  });
+}
+
+template<typename TU>
+inline void TimingWheel<TU>::stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopped = true;
+  }
+  m_condition.notify_all();
+  if(m_thread.joinable()) m_thread.join();
+}
+
+} // namespace signal_processors
+
+} // namespace rh
+
+#endif // __TimingWheel_hpp__
@@ -9,6 +9,9 @@
 
 #pragma once
 #include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace rh {
@@ -212,12 +215,12 @@ struct Signal<void(A...)> : details::SignalBase {
     if(!calling) calling = 1;
     for(size_t i = 0, n = calls.size(); i < n; ++i) {
       auto& cb = calls[i];
-      if(cb.func) {
-        if(cb.object == cb.func)
-          reinterpret_cast<void (*)(A...)>(cb.func)(
+      if(cb.function) {
+        if(cb.object == cb.function)
+          reinterpret_cast<void (*)(A...)>(cb.function)(
             std::forward<ActualArgsT>(args)...);
         else
-          reinterpret_cast<void (*)(void*, A...)>(cb.func)(
+          reinterpret_cast<void (*)(void*, A...)>(cb.function)(
             &cb.object, std::forward<ActualArgsT>(args)...);
       }
     }
@@ -234,7 +237,7 @@ struct Signal<void(A...)> : details::SignalBase {
           if(connections[i]) {
             connections[sz] = connections[i];
             calls[sz] = calls[i];
-            connections[sz]->idx = sz;
+            connections[sz]->index = sz;
             ++sz;
           }
         }
@@ -249,7 +252,7 @@ struct Signal<void(A...)> : details::SignalBase {
     size_t idx = connections.size();
     auto& call = calls.emplace_back();
     call.object = object;
-    call.func = reinterpret_cast<void*>(+[](void* obj, A... args) {
+    call.function = reinterpret_cast<void*>(+[](void* obj, A... args) {
       ((*reinterpret_cast<C**>(obj))->*PMF)(args...);
     });
     details::ConnectionBase* conn = new details::ConnectionBase(
@@ -266,7 +269,7 @@ struct Signal<void(A...)> : details::SignalBase {
   ConnectionRaw connect(void (*function)(A...)) const {
     size_t idx = connections.size();
     auto& call = calls.emplace_back();
-    call.func = call.object = reinterpret_cast<void*>(function);
+    call.function = call.object = reinterpret_cast<void*>(function);
     details::ConnectionBase* conn = new details::ConnectionBase(
       this, idx);
     connections.emplace_back(conn);
@@ -282,7 +285,7 @@ struct Signal<void(A...)> : details::SignalBase {
     else if constexpr(std::is_lvalue_reference_v<F>) {
       size_t idx = connections.size();
       auto& call = calls.emplace_back();
-      call.func = reinterpret_cast<void*>(+[](void* obj, A... args) {
+      call.function = reinterpret_cast<void*>(+[](void* obj, A... args) {
         (*reinterpret_cast<f_type**>(obj))->operator()(args...);
       });
       call.object = &functor;
@@ -296,7 +299,7 @@ struct Signal<void(A...)> : details::SignalBase {
       // copy the functor.
       size_t idx = connections.size();
       auto& call = calls.emplace_back();
-      call.func = reinterpret_cast<void*>(+[](void* obj, A... args) {
+      call.function = reinterpret_cast<void*>(+[](void* obj, A... args) {
         reinterpret_cast<f_type*>(obj)->operator()(args...);
       });
       new(&call.object) f_type(std::move(functor));
@@ -323,7 +326,7 @@ struct Signal<void(A...)> : details::SignalBase {
 
       size_t idx = connections.size();
       auto& call = calls.emplace_back();
-      call.func = reinterpret_cast<void*>(+[](void* obj, A... args) {
+      call.function = reinterpret_cast<void*>(+[](void* obj, A... args) {
         reinterpret_cast<unique*>(obj)->ptr->operator()(args...);
       });
       new(&call.object) unique{new f_type(std::move(functor))};
@@ -335,6 +338,116 @@ struct Signal<void(A...)> : details::SignalBase {
   }
 };
 
+namespace details {
+
+template <typename T> struct MemberFunctionObject;
+
+template <typename R, typename C, typename... P>
+struct MemberFunctionObject<R (C::*)(P...)> { using type = C; };
+
+template <typename R, typename C, typename... P>
+struct MemberFunctionObject<R (C::*)(P...) const> { using type = const C; };
+
+template <typename R, typename C, typename... P>
+struct MemberFunctionObject<R (C::*)(P...) noexcept> { using type = C; };
+
+template <typename R, typename C, typename... P>
+struct MemberFunctionObject<R (C::*)(P...) const noexcept> {
+  using type = const C;
+};
+
+// Free functions and stateless callables need no storage; member
+// function slots keep the object pointer they are connected to.
+template <size_t I, auto Slot,
+          bool = std::is_member_function_pointer_v<decltype(Slot)>>
+struct StaticSlot {
+  template <typename... ActualArgsT>
+  void call(ActualArgsT&... args) const {
+    Slot(args...);
+  }
+};
+
+template <size_t I, auto Slot>
+struct StaticSlot<I, Slot, true> {
+  using Object = typename MemberFunctionObject<decltype(Slot)>::type;
+
+  Object* object{nullptr};
+
+  template <typename... ActualArgsT>
+  void call(ActualArgsT&... args) const {
+    if(object) (object->*Slot)(args...);
+  }
+
+  template <auto PMF, class C>
+  void connect(C* other) {
+    if constexpr(std::is_same_v<decltype(Slot), decltype(PMF)>) {
+      if(Slot == PMF) object = other;
+    }
+  }
+};
+
+template <typename Indexes, auto... Slots> struct StaticSlots;
+
+template <size_t... I, auto... Slots>
+struct StaticSlots<std::index_sequence<I...>, Slots...>
+    : StaticSlot<I, Slots>...
+{
+  template <typename... ActualArgsT>
+  void call(ActualArgsT&... args) const {
+    (StaticSlot<I, Slots>::call(args...), ...);
+  }
+
+  template <auto PMF, class C>
+  void connect(C* object) {
+    (connectSlot<PMF, StaticSlot<I, Slots>>(object), ...);
+  }
+
+ private:
+  template <auto PMF, typename S, class C>
+  void connectSlot(C* object) {
+    if constexpr(!std::is_empty_v<S>) S::template connect<PMF>(object);
+  }
+};
+
+} // namespace details
+
+template<typename F, auto... Slots> struct StaticSignal;
+
+// Signal with a fixed set of slots known at compile time. Slots are
+// free function pointers, stateless callables (C++20) or member
+// function pointers. Emission calls every slot directly in declaration
+// order, so the calls can be inlined; only member function slots take
+// storage (one object pointer each, set with connect<PMF>(object)).
+template <typename... A, auto... Slots>
+struct StaticSignal<void(A...), Slots...>
+    : private details::StaticSlots<
+        std::index_sequence_for<decltype(Slots)...>, Slots...>
+{
+  StaticSignal() = default;
+
+  template <typename... ActualArgsT>
+  void operator()(ActualArgsT&&... args) const {
+    Base::call(args...);
+  }
+
+  template <auto PMF, class C>
+  void connect(C* object) {
+    Base::template connect<PMF>(object);
+  }
+
+  template <auto PMF>
+  void disconnect() {
+    Base::template connect<PMF>(
+      static_cast<
+        typename details::MemberFunctionObject<decltype(PMF)>::type*>(
+          nullptr));
+  }
+
+ private:
+  using Base = details::StaticSlots<
+    std::index_sequence_for<decltype(Slots)...>, Slots...>;
+};
+
 } // namespace signals
 
 } // namespace rh